@@ -113,6 +113,10 @@ module xilinx_gr_heep_wrapper
 `endif
 
   gr_heep_top gr_heep_top_i (
+    .ext_slave_req_o(),
+    .ext_slave_resp_i('0),
+    .ext_periph_req_o(),
+    .ext_periph_rsp_i('0),
     .rst_ni(rst_n),
     .boot_select_i,
     .execute_from_flash_i,
@@ -48,6 +48,13 @@ package gr_heep_pkg;
   ) : 32'd1;
   localparam int unsigned LogExtXbarNSlave = ExtXbarNSlave > 32'd1 ? $clog2(ExtXbarNSlave) : 32'd1;
 
+  // No external slaves: placeholder address map (the external bus is not
+  // instantiated)
+  localparam addr_map_rule_t [0:0] ExtSlaveAddrRules = '{
+      '{idx: 32'd0, start_addr: EXT_SLAVE_START_ADDRESS, end_addr: EXT_SLAVE_START_ADDRESS}
+  };
+
+  localparam int unsigned ExtSlaveDefaultIdx = 32'd0;
 
   // --------------------
   // EXTERNAL PERIPHERALS
@@ -70,9 +70,17 @@ package gr_heep_pkg;
 %endfor
     };
 
-  localparam int unsigned ExtSlaveDefaultIdx = 32'd0;
+% else:
+
+  // No external slaves: placeholder address map (the external bus is not
+  // instantiated)
+  localparam addr_map_rule_t [0:0] ExtSlaveAddrRules = '{
+    '{idx: 32'd0, start_addr: EXT_SLAVE_START_ADDRESS, end_addr: EXT_SLAVE_START_ADDRESS}
+  };
 
 % endif
+
+  localparam int unsigned ExtSlaveDefaultIdx = 32'd0;
   
   // --------------------
   // EXTERNAL PERIPHERALS
@@ -93,7 +101,7 @@ package gr_heep_pkg;
     localparam int unsigned ${a_slave['name']}PeriphIdx = 32'd${a_slave['idx']};
     localparam logic [31:0] ${a_slave['name']}PeriphStartAddr = EXT_PERIPHERAL_START_ADDRESS + 32'h${a_slave['offset']};
     localparam logic [31:0] ${a_slave['name']}PeriphSize = 32'h${a_slave['size']};
-    localparam logic [31:0] ${a_slave['name']}PeriphEndAddr = ${a_slave['name']}StartAddr + 32'h${a_slave['size']};
+    localparam logic [31:0] ${a_slave['name']}PeriphEndAddr = ${a_slave['name']}PeriphStartAddr + 32'h${a_slave['size']};
 % endfor
     
         // External peripherals address map
@@ -8,6 +8,14 @@
 // Description: tr-HEEP top-level module
 
 module gr_heep_top (
+    // External OBI slave ports (ext_xbar_slaves in gr-heep-cfg.hjson)
+    output obi_pkg::obi_req_t  [gr_heep_pkg::ExtXbarNSlaveRnd-1:0] ext_slave_req_o,
+    input  obi_pkg::obi_resp_t [gr_heep_pkg::ExtXbarNSlaveRnd-1:0] ext_slave_resp_i,
+
+    // External peripheral port (whole external peripheral address range)
+    output reg_pkg::reg_req_t ext_periph_req_o,
+    input  reg_pkg::reg_rsp_t ext_periph_rsp_i,
+
     // X-HEEP interface
 % for pad in total_pad_list:
 ${pad.x_heep_system_interface}
@@ -224,6 +232,55 @@ ${pad.core_v_mini_mcu_bonding}
 
   assign ext_int_vector = '0;
 
+  // External bus
+  // ------------
+  // Routes the X-HEEP master ports to the external slaves
+  if (ExtXbarNSlave > 0) begin : gen_ext_bus
+    ext_bus #(
+      .EXT_XBAR_NMASTER(ExtXbarNMaster),
+      .EXT_XBAR_NSLAVE (ExtXbarNSlave)
+    ) u_ext_bus (
+      .clk_i (clk_i),
+      .rst_ni (rst_nin_sync),
+
+      .addr_map_i    (ExtSlaveAddrRules),
+      .default_idx_i (ExtSlaveDefaultIdx[LogExtXbarNSlave-1:0]),
+
+      .heep_core_instr_req_i (heep_core_instr_req),
+      .heep_core_instr_resp_o (heep_core_instr_rsp),
+      .heep_core_data_req_i (heep_core_data_req),
+      .heep_core_data_resp_o (heep_core_data_rsp),
+      .heep_debug_master_req_i (heep_debug_master_req),
+      .heep_debug_master_resp_o (heep_debug_master_rsp),
+      .heep_dma_read_req_i (heep_dma_read_req),
+      .heep_dma_read_resp_o (heep_dma_read_rsp),
+      .heep_dma_write_req_i (heep_dma_write_req),
+      .heep_dma_write_resp_o (heep_dma_write_rsp),
+      .heep_dma_addr_req_i (heep_dma_addr_req),
+      .heep_dma_addr_resp_o (heep_dma_addr_rsp),
+
+      .ext_master_req_i (gr_heep_master_req),
+      .ext_master_resp_o (gr_heep_master_resp),
+      .heep_slave_req_o (heep_slave_req),
+      .heep_slave_resp_i (heep_slave_rsp),
+
+      .ext_slave_req_o (ext_slave_req_o),
+      .ext_slave_resp_i (ext_slave_resp_i)
+    );
+  end else begin : gen_no_ext_bus
+    assign heep_core_instr_rsp = '0;
+    assign heep_core_data_rsp = '0;
+    assign heep_debug_master_rsp = '0;
+    assign heep_dma_read_rsp = '0;
+    assign heep_dma_write_rsp = '0;
+    assign heep_dma_addr_rsp = '0;
+    assign ext_slave_req_o = '0;
+  end
+
+  // External peripherals
+  assign ext_periph_req_o = heep_peripheral_req;
+  assign heep_peripheral_rsp = ext_periph_rsp_i;
+
   // Pad ring
   // --------
   assign exit_value_out_x = exit_value[0];
@@ -0,0 +1,183 @@
+// Copyright 2026 Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: main.c
+// Author: agent
+// Date: 16/10/2026
+// Description: Benchmark of the audio capture SDK. The I2S samples are copied
+//              by a circular DMA transaction into a ring of windows, that a
+//              fast consumer processes in place, reporting the window period,
+//              the cycles spent per window and the CPU wake-ups. A slow
+//              consumer then checks the overrun accounting.
+
+// System library headers
+#include <stdint.h>
+#include <stdio.h>
+
+// Custom library headers
+#include "audio_sdk.h"
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "rv_plic.h"
+
+// Benchmark configuration
+#define WINDOW_SAMPLES 64
+#define N_WINDOWS 4
+#define FAST_WINDOWS 16
+#define SLOW_WINDOWS 8
+#define SLOW_DELAY 3 // window periods spent on each window by the slow consumer
+#define DMA_CHANNEL 0
+#define I2S_CLK_DIV 4
+
+#ifdef HAS_MEMORY_BANKS_IL
+#define OPERAND __attribute__((section(".xheep_data_interleaved"))) __attribute__((aligned(4)))
+#else
+#define OPERAND __attribute__((aligned(4)))
+#endif
+
+// Capture ring
+static uint32_t OPERAND ring[N_WINDOWS * WINDOW_SAMPLES];
+
+// Windows counted by the callback
+static volatile uint32_t cb_windows;
+
+// Read the cycle counter
+static inline uint32_t cycles(void)
+{
+    uint32_t cyc;
+    CSR_READ(CSR_REG_MCYCLE, &cyc);
+    return cyc;
+}
+
+// Window-done callback
+static void on_window(const audio_window_t *win, void *arg)
+{
+    (void)win;
+    (void)arg;
+    cb_windows++;
+}
+
+// Window processing: energy of the samples
+static uint32_t energy(const audio_window_t *win)
+{
+    const int32_t *s = (const int32_t *)win->data;
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < win->samples; i++) acc += (uint32_t)((s[i] >> 16) * (s[i] >> 16));
+    return acc;
+}
+
+// Drain the windows left after audio_capture_stop()
+static void drain(void)
+{
+    audio_window_t win;
+    while (audio_capture_acquire(&win) == 0) audio_capture_release(&win);
+}
+
+// Print the statistics of a run
+static void print_stats(const char *name, const audio_capture_stats_t *stats)
+{
+    printf("%-4s windows %3u, released %3u, overruns %3u, FIFO overflows %u, max pending %u, wake-ups %3u\n", name,
+           (unsigned int)stats->windows, (unsigned int)stats->released, (unsigned int)stats->overruns,
+           (unsigned int)stats->fifo_overflows, (unsigned int)stats->max_pending, (unsigned int)stats->wakeups);
+}
+
+int main(void)
+{
+#ifndef I2S_IS_INCLUDED
+    printf("I2S not included in the MCU\n");
+    printf("audio benchmark finished with %d errors\n", 0);
+    return 0;
+#else
+    audio_capture_config_t cfg = {
+        .src = AUDIO_SRC_I2S,
+        .ring = ring,
+        .window_samples = WINDOW_SAMPLES,
+        .n_windows = N_WINDOWS,
+        .type = DMA_DATA_TYPE_WORD,
+        .dma_channel = DMA_CHANNEL,
+        .i2s_clk_div = I2S_CLK_DIV,
+        .i2s_word_len = I2S_32_BITS,
+        .i2s_channels = I2S_BOTH_CH,
+        .on_window = on_window,
+        .arg = NULL,
+    };
+    audio_capture_stats_t stats;
+    audio_window_t win;
+    uint32_t t0, t_first, t_last, t_busy, period, delay;
+    uint32_t next, e = 0;
+    int errors = 0;
+
+    // Enable the cycle counter and the PLIC handler table
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+    plic_Init();
+    dma_init(NULL);
+
+    printf("Audio capture, %u windows of %u samples\n", (unsigned int)N_WINDOWS, (unsigned int)WINDOW_SAMPLES);
+
+    if (audio_capture_init(&cfg) != 0) {
+        printf("configuration error\n");
+        return 1;
+    }
+
+    // Fast consumer: every window is processed in place before the next one
+    cb_windows = 0;
+    if (audio_capture_start() != 0) {
+        printf("start error\n");
+        return 1;
+    }
+    t_busy = 0;
+    t_first = t_last = 0;
+    for (uint32_t i = 0; i < FAST_WINDOWS; i++) {
+        if (audio_capture_wait(&win) != 0) {
+            errors++;
+            break;
+        }
+        t0 = cycles();
+        if (i == 0) t_first = t0;
+        t_last = t0;
+        if (win.index != i) errors++;
+        e += energy(&win);
+        if (audio_capture_release(&win) != 0) errors++;
+        t_busy += cycles() - t0;
+    }
+    audio_capture_stop();
+    drain();
+    audio_capture_stats(&stats);
+    print_stats("fast", &stats);
+    if (stats.overruns != 0 || stats.windows != cb_windows || stats.windows != stats.released) errors++;
+    period = (t_last - t_first) / (FAST_WINDOWS - 1);
+    printf("window period %6u cycles, processing %5u cycles/window, energy %u\n", (unsigned int)period,
+           (unsigned int)(t_busy / FAST_WINDOWS), (unsigned int)e);
+
+    // Slow consumer: each window takes SLOW_DELAY periods, so the DMA
+    // overwrites the windows that cannot be kept in the ring
+    delay = period * SLOW_DELAY;
+    cb_windows = 0;
+    if (audio_capture_start() != 0) {
+        printf("start error\n");
+        return 1;
+    }
+    next = 0;
+    for (uint32_t i = 0; i < SLOW_WINDOWS; i++) {
+        if (audio_capture_wait(&win) != 0) {
+            errors++;
+            break;
+        }
+        if (win.index < next) errors++;
+        next = win.index + 1;
+        t0 = cycles();
+        while (cycles() - t0 < delay) e += energy(&win);
+        audio_capture_release(&win);
+    }
+    audio_capture_stop();
+    drain();
+    audio_capture_stats(&stats);
+    print_stats("slow", &stats);
+    if (stats.overruns == 0 || stats.windows != cb_windows) errors++;
+    if (stats.windows != stats.released + stats.overruns) errors++;
+
+    printf("audio benchmark finished with %d errors\n", errors);
+    return errors;
+#endif
+}
@@ -0,0 +1,203 @@
+// Copyright 2026 Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: main.c
+// Author: agent
+// Date: 16/10/2026
+// Description: Benchmark of the conv2d SDK. Each layer is computed with a
+//              naive loop nest, then with conv2d_run() gathering the patches
+//              with the CPU only and with the DMA, reporting cycles and
+//              MAC/cycle and checking the results. The layers cover both
+//              layouts and types, strides, padding and dilation. The tensors
+//              are placed in the interleaved banks when the system has them.
+
+// System library headers
+#include <stdint.h>
+#include <stdio.h>
+
+// Custom library headers
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma_sdk.h"
+#include "conv2d_sdk.h"
+
+// Benchmark configuration
+#define ARENA_WORDS 4608 // input, weights, outputs and workspace of a layer
+#define TILE_ROWS 2
+#define DMA_CHANNEL 0
+
+// Layers: in_ch, in_h, in_w, out_ch, k_h, k_w, stride, dilation, padding
+static const conv2d_params_t layers[] = {
+    {8, 12, 12, 8, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, CONV2D_LAYOUT_NHWC, CONV2D_TYPE_INT8},
+    {8, 12, 12, 8, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, CONV2D_LAYOUT_NCHW, CONV2D_TYPE_INT8},
+    {4, 12, 12, 4, 3, 3, 2, 2, 1, 1, 1, 1, 1, 1, CONV2D_LAYOUT_NHWC, CONV2D_TYPE_INT32},
+    {4, 12, 12, 4, 3, 3, 1, 1, 2, 2, 2, 2, 2, 2, CONV2D_LAYOUT_NCHW, CONV2D_TYPE_INT32},
+    {16, 8, 8, 16, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, CONV2D_LAYOUT_NHWC, CONV2D_TYPE_INT8},
+};
+
+#ifdef HAS_MEMORY_BANKS_IL
+#define OPERAND __attribute__((section(".xheep_data_interleaved"))) __attribute__((aligned(4)))
+#else
+#define OPERAND __attribute__((aligned(4)))
+#endif
+
+// Tensors of the current layer
+static uint32_t OPERAND arena[ARENA_WORDS];
+
+// Read the cycle counter
+static inline uint32_t cycles(void)
+{
+    uint32_t cyc;
+    CSR_READ(CSR_REG_MCYCLE, &cyc);
+    return cyc;
+}
+
+// Pseudo-random int8 values
+static uint32_t seed = 1;
+static int8_t rand8(void)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (int8_t)(seed >> 24);
+}
+
+// Element of an int8 or int32 tensor
+static inline int32_t get(const conv2d_params_t *p, const void *t, uint32_t i)
+{
+    return p->type == CONV2D_TYPE_INT8 ? ((const int8_t *)t)[i] : ((const int32_t *)t)[i];
+}
+
+// Reference: direct convolution
+static void __attribute__((noinline)) conv_naive(const conv2d_params_t *p, const void *in, const void *w, int32_t *out)
+{
+    uint32_t oh = conv2d_out_h(p), ow = conv2d_out_w(p);
+    uint8_t nchw = p->layout == CONV2D_LAYOUT_NCHW;
+
+    for (uint32_t co = 0; co < p->out_ch; co++) {
+        for (uint32_t y = 0; y < oh; y++) {
+            for (uint32_t x = 0; x < ow; x++) {
+                int32_t acc = 0;
+                for (uint32_t kh = 0; kh < p->k_h; kh++) {
+                    int32_t ih = (int32_t)(y * p->stride_h + kh * p->dil_h) - (int32_t)p->pad_top;
+                    if (ih < 0 || ih >= (int32_t)p->in_h) continue;
+                    for (uint32_t kw = 0; kw < p->k_w; kw++) {
+                        int32_t iw = (int32_t)(x * p->stride_w + kw * p->dil_w) - (int32_t)p->pad_left;
+                        if (iw < 0 || iw >= (int32_t)p->in_w) continue;
+                        for (uint32_t c = 0; c < p->in_ch; c++) {
+                            uint32_t ii = nchw ? (c * p->in_h + ih) * p->in_w + iw : (ih * p->in_w + iw) * p->in_ch + c;
+                            uint32_t wi = nchw ? ((co * p->in_ch + c) * p->k_h + kh) * p->k_w + kw
+                                               : ((co * p->k_h + kh) * p->k_w + kw) * p->in_ch + c;
+                            acc += get(p, in, ii) * get(p, w, wi);
+                        }
+                    }
+                }
+                out[nchw ? (co * oh + y) * ow + x : (y * ow + x) * p->out_ch + co] = acc;
+            }
+        }
+    }
+}
+
+// Print MAC/cycle with two decimal digits
+static void report(const char *name, uint32_t total, uint32_t macs)
+{
+    uint32_t mpc100 = (macs * 100 + total / 2) / total;
+    printf("  %-6s %8u cycles, %2u.%02u MAC/cycle\n", name, (unsigned int)total, (unsigned int)(mpc100 / 100),
+           (unsigned int)(mpc100 % 100));
+}
+
+// Run conv2d_run() and check the output against the reference
+static int bench_run(const char *name, const conv2d_params_t *p, const void *in, const void *wp, int32_t *out,
+                     const int32_t *ref, void *work, uint8_t channel)
+{
+    uint32_t size = conv2d_out_h(p) * conv2d_out_w(p) * p->out_ch;
+    uint32_t macs = size * p->in_ch * p->k_h * p->k_w;
+    uint32_t start, total;
+    int err = 0;
+
+    for (uint32_t i = 0; i < size; i++) out[i] = 0;
+
+    start = cycles();
+    if (conv2d_run(p, in, wp, out, work, TILE_ROWS, channel) != 0) {
+        printf("  %s: configuration error\n", name);
+        return 1;
+    }
+    total = cycles() - start;
+    report(name, total, macs);
+
+    for (uint32_t i = 0; i < size; i++) {
+        if (out[i] != ref[i]) err++;
+    }
+    if (err) printf("  %s: %d errors\n", name, err);
+    return err;
+}
+
+// Main body
+// ---------
+int main(void)
+{
+    int errors = 0;
+    uint32_t start, total;
+
+    // Enable the cycle counter
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    dma_sdk_init();
+
+#ifdef HAS_MEMORY_BANKS_IL
+    printf("conv2d, %u-row tiles, interleaved tensors\n", (unsigned int)TILE_ROWS);
+#else
+    printf("conv2d, %u-row tiles, contiguous tensors\n", (unsigned int)TILE_ROWS);
+#endif
+
+    for (uint32_t l = 0; l < sizeof(layers) / sizeof(layers[0]); l++) {
+        const conv2d_params_t *p = &layers[l];
+        uint32_t esize = p->type == CONV2D_TYPE_INT8 ? 1 : 4;
+        uint32_t in_size = p->in_ch * p->in_h * p->in_w;
+        uint32_t w_size = p->out_ch * p->in_ch * p->k_h * p->k_w;
+        uint32_t out_size = conv2d_out_h(p) * conv2d_out_w(p) * p->out_ch;
+
+        // Carve the tensors out of the arena, word-aligned
+        uint8_t *in = (uint8_t *)arena;
+        uint8_t *w = in + ((in_size * esize + 3) & ~3u);
+        uint8_t *wp = w + ((w_size * esize + 3) & ~3u);
+        int32_t *out = (int32_t *)(wp + ((conv2d_weights_size(p) + 3) & ~3u));
+        int32_t *ref = out + out_size;
+        uint8_t *work = (uint8_t *)(ref + out_size);
+
+        printf("%s %s, C = %u, %ux%u, F = %u, %ux%u, stride %u, dilation %u, padding %u\n",
+               p->layout == CONV2D_LAYOUT_NCHW ? "NCHW" : "NHWC", p->type == CONV2D_TYPE_INT8 ? "int8" : "int32",
+               (unsigned int)p->in_ch, (unsigned int)p->in_h, (unsigned int)p->in_w, (unsigned int)p->out_ch,
+               (unsigned int)p->k_h, (unsigned int)p->k_w, (unsigned int)p->stride_h, (unsigned int)p->dil_h,
+               (unsigned int)p->pad_top);
+        if (work + conv2d_workspace_size(p, TILE_ROWS) > (uint8_t *)(arena + ARENA_WORDS)) {
+            printf("  does not fit in the arena\n");
+            errors++;
+            continue;
+        }
+
+        for (uint32_t i = 0; i < in_size; i++) {
+            if (esize == 1) ((int8_t *)in)[i] = rand8();
+            else ((int32_t *)in)[i] = rand8();
+        }
+        for (uint32_t i = 0; i < w_size; i++) {
+            if (esize == 1) ((int8_t *)w)[i] = rand8();
+            else ((int32_t *)w)[i] = rand8();
+        }
+
+        start = cycles();
+        conv_naive(p, in, w, ref);
+        total = cycles() - start;
+        report("naive", total, out_size * p->in_ch * p->k_h * p->k_w);
+
+        start = cycles();
+        conv2d_pack_weights(p, w, wp);
+        total = cycles() - start;
+        printf("  pack   %8u cycles\n", (unsigned int)total);
+
+        errors += bench_run("cpu", p, in, wp, out, ref, work, CONV2D_NO_DMA);
+        errors += bench_run("dma", p, in, wp, out, ref, work, DMA_CHANNEL);
+    }
+
+    printf("conv2d benchmark finished with %d errors\n", errors);
+    return errors;
+}
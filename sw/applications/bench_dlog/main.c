@@ -0,0 +1,84 @@
+// Copyright 2026 Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: main.c
+// Author: agent
+// Date: 16/10/2026
+// Description: Benchmark of the deferred-format log. The same trace of a
+//              control loop is emitted with printf() and with DLOG(),
+//              reporting the cycles per message. Build with
+//              CDEFS=DLOG_DEFERRED and simulate with DLOG=1 to have the
+//              DLOG() messages decoded by the Verilator testbench into
+//              dlog.log; otherwise DLOG() is a printf() as well.
+
+// System library headers
+#include <stdint.h>
+#include <stdio.h>
+
+// Custom library headers
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dlog_sdk.h"
+
+// Benchmark configuration
+#define STEPS 32
+
+// Read the cycle counter
+static inline uint32_t cycles(void)
+{
+    uint32_t cyc;
+    CSR_READ(CSR_REG_MCYCLE, &cyc);
+    return cyc;
+}
+
+// One step of a toy controller
+static inline int32_t control(int32_t *state, int32_t ref)
+{
+    int32_t err = ref - *state;
+    *state += err / 4;
+    return err;
+}
+
+int main(void)
+{
+    int32_t state, err;
+    uint32_t t0, t_printf, t_dlog;
+    int errors = 0;
+
+    // Enable the cycle counter
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    // Trace with printf()
+    state = 0;
+    t0 = cycles();
+    for (int i = 0; i < STEPS; i++) {
+        err = control(&state, 1000);
+        printf("step %2d: state %5d, error %5d\n", i, (int)state, (int)err);
+    }
+    t_printf = cycles() - t0;
+
+    // Same trace with DLOG()
+    state = 0;
+    t0 = cycles();
+    for (int i = 0; i < STEPS; i++) {
+        err = control(&state, 1000);
+        DLOG("step %2d: state %5d, error %5d\n", i, state, err);
+    }
+    t_dlog = cycles() - t0;
+
+#ifdef DLOG_DEFERRED
+    printf("DLOG() deferred to the host\n");
+#else
+    printf("DLOG() formatted by printf()\n");
+#endif
+    printf("printf %6u cycles/message\n", (unsigned int)(t_printf / STEPS));
+    printf("DLOG   %6u cycles/message\n", (unsigned int)(t_dlog / STEPS));
+    if (dlog_dropped() != 0) {
+        printf("%u messages dropped\n", (unsigned int)dlog_dropped());
+        errors++;
+    }
+
+    printf("dlog benchmark finished with %d errors\n", errors);
+    return errors;
+}
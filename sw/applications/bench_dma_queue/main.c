@@ -0,0 +1,223 @@
+// Copyright 2026 Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: main.c
+// Author: agent
+// Date: 16/10/2026
+// Description: Benchmark of the DMA setup overhead for a stream of small 2D
+//              transfers (tiles extracted from a matrix). Each tile is copied
+//              with the driver flow (validate, load, launch), with a compiled
+//              descriptor retargeted for every tile, and with a descriptor
+//              queue launched from the transaction-done interrupt.
+
+// System library headers
+#include <stdint.h>
+#include <stdio.h>
+
+// Custom library headers
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+
+// Benchmark configuration
+#define MAT_SIZE 32                   // square input matrix (words)
+#define TILE_SIZE 4                   // square tiles (words)
+#define TILES_PER_ROW (MAT_SIZE / TILE_SIZE)
+#define TILE_NUM (TILES_PER_ROW * TILES_PER_ROW)
+#define TILE_WORDS (TILE_SIZE * TILE_SIZE)
+
+// Input matrix and output tiles (stored contiguously)
+static uint32_t mat[MAT_SIZE * MAT_SIZE];
+static uint32_t tiles[TILE_NUM * TILE_WORDS];
+
+// DMA configuration
+static dma_target_t tgt_src;
+static dma_target_t tgt_dst;
+static dma_trans_t trans;
+static dma_desc_t descs[TILE_NUM];
+
+// Read the cycle counter
+static inline uint32_t cycles(void)
+{
+    uint32_t cyc;
+    CSR_READ(CSR_REG_MCYCLE, &cyc);
+    return cyc;
+}
+
+// Pointer to the first element of a tile in the input matrix
+static inline uint32_t *tile_ptr(uint32_t t)
+{
+    return &mat[(t / TILES_PER_ROW) * TILE_SIZE * MAT_SIZE + (t % TILES_PER_ROW) * TILE_SIZE];
+}
+
+// Clear the output and set the transaction for the first tile
+static void setup(dma_trans_end_evt_t end)
+{
+    for (uint32_t i = 0; i < TILE_NUM * TILE_WORDS; i++) tiles[i] = 0;
+
+    tgt_src.ptr = (uint8_t *)tile_ptr(0);
+    tgt_src.inc_d1_du = 1;
+    tgt_src.inc_d2_du = MAT_SIZE - TILE_SIZE + 1;
+    tgt_src.trig = DMA_TRIG_MEMORY;
+    tgt_src.type = DMA_DATA_TYPE_WORD;
+
+    tgt_dst.ptr = (uint8_t *)tiles;
+    tgt_dst.inc_d1_du = 1;
+    tgt_dst.inc_d2_du = 1;
+    tgt_dst.trig = DMA_TRIG_MEMORY;
+    tgt_dst.type = DMA_DATA_TYPE_WORD;
+
+    trans.src = &tgt_src;
+    trans.dst = &tgt_dst;
+    trans.src_addr = NULL;
+    trans.mode = DMA_TRANS_MODE_SINGLE;
+    trans.dim = DMA_DIM_CONF_2D;
+    trans.size_d1_du = TILE_SIZE;
+    trans.size_d2_du = TILE_SIZE;
+    trans.pad_top_du = 0;
+    trans.pad_bottom_du = 0;
+    trans.pad_left_du = 0;
+    trans.pad_right_du = 0;
+    trans.src_type = DMA_DATA_TYPE_WORD;
+    trans.dst_type = DMA_DATA_TYPE_WORD;
+    trans.sign_ext = 0;
+    trans.dim_inv = 0;
+    trans.win_du = 0;
+    trans.end = end;
+    trans.channel = 0;
+}
+
+// Check the output tiles
+static int check(const char *name)
+{
+    int errors = 0;
+    for (uint32_t t = 0; t < TILE_NUM; t++) {
+        uint32_t *src = tile_ptr(t);
+        for (uint32_t r = 0; r < TILE_SIZE; r++) {
+            for (uint32_t c = 0; c < TILE_SIZE; c++) {
+                if (tiles[t * TILE_WORDS + r * TILE_SIZE + c] != src[r * MAT_SIZE + c]) errors++;
+            }
+        }
+    }
+    if (errors) printf("%s: %d errors\n", name, errors);
+    return errors;
+}
+
+// Print the results of a run
+static void report(const char *name, uint32_t setup_cycles, uint32_t total_cycles)
+{
+    printf("%-10s setup: %6u cycles (%4u/transfer), total: %7u cycles (%4u/transfer)\n", name,
+           (unsigned int)setup_cycles, (unsigned int)(setup_cycles / TILE_NUM), (unsigned int)total_cycles,
+           (unsigned int)(total_cycles / TILE_NUM));
+}
+
+// Driver flow: validate, load and launch every tile
+static int bench_driver(void)
+{
+    uint32_t setup_cycles = 0;
+    uint32_t start, total;
+
+    setup(DMA_TRANS_END_POLLING);
+    start = cycles();
+    for (uint32_t t = 0; t < TILE_NUM; t++) {
+        uint32_t t0 = cycles();
+        tgt_src.ptr = (uint8_t *)tile_ptr(t);
+        tgt_dst.ptr = (uint8_t *)&tiles[t * TILE_WORDS];
+        if (dma_validate_transaction(&trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY) != DMA_CONFIG_OK ||
+            dma_load_transaction(&trans) != DMA_CONFIG_OK || dma_launch(&trans) != DMA_CONFIG_OK) {
+            printf("driver: configuration error\n");
+            return 1;
+        }
+        setup_cycles += cycles() - t0;
+        while (!dma_is_ready(0));
+    }
+    total = cycles() - start;
+
+    report("driver", setup_cycles, total);
+    return check("driver");
+}
+
+// Compiled descriptor, retargeted to every tile
+static int bench_desc(void)
+{
+    uint32_t setup_cycles;
+    uint32_t start, total, t0;
+
+    setup(DMA_TRANS_END_POLLING);
+    start = cycles();
+    if (dma_validate_transaction(&trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY) != DMA_CONFIG_OK ||
+        dma_compile_transaction(&trans, &descs[0]) != DMA_CONFIG_OK) {
+        printf("desc: configuration error\n");
+        return 1;
+    }
+    setup_cycles = cycles() - start;
+    for (uint32_t t = 0; t < TILE_NUM; t++) {
+        t0 = cycles();
+        dma_desc_set_ptrs(&descs[0], tile_ptr(t), &tiles[t * TILE_WORDS]);
+        dma_desc_launch(&descs[0]);
+        setup_cycles += cycles() - t0;
+        while (!dma_is_ready(0));
+    }
+    total = cycles() - start;
+
+    report("desc", setup_cycles, total);
+    return check("desc");
+}
+
+// Descriptor queue, advanced by the transaction-done interrupt
+static int bench_queue(void)
+{
+    uint32_t setup_cycles;
+    uint32_t start, total, t0;
+
+    setup(DMA_TRANS_END_INTR);
+    start = cycles();
+    if (dma_validate_transaction(&trans, DMA_ENABLE_REALIGN, DMA_PERFORM_CHECKS_INTEGRITY) != DMA_CONFIG_OK ||
+        dma_compile_transaction(&trans, &descs[0]) != DMA_CONFIG_OK) {
+        printf("queue: configuration error\n");
+        return 1;
+    }
+    for (uint32_t t = 1; t < TILE_NUM; t++) descs[t] = descs[0];
+    setup_cycles = cycles() - start;
+
+    // Build and push all the descriptors, then wait for the queue to drain
+    for (uint32_t t = 0; t < TILE_NUM; t++) {
+        t0 = cycles();
+        dma_desc_set_ptrs(&descs[t], tile_ptr(t), &tiles[t * TILE_WORDS]);
+        if (dma_queue_push(&descs[t]) != DMA_CONFIG_OK) {
+            dma_queue_wait(0);
+            printf("queue: channel busy\n");
+            return 1;
+        }
+        setup_cycles += cycles() - t0;
+    }
+    dma_queue_wait(0);
+    total = cycles() - start;
+
+    report("queue", setup_cycles, total);
+    return check("queue");
+}
+
+// Main body
+// ---------
+int main(void)
+{
+    int errors = 0;
+
+    // Enable the cycle counter and global interrupts
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    // Initialize the input matrix
+    for (uint32_t i = 0; i < MAT_SIZE * MAT_SIZE; i++) mat[i] = i * 0x01000193u;
+
+    dma_init(NULL);
+    printf("%u transfers of %ux%u words\n", (unsigned int)TILE_NUM, (unsigned int)TILE_SIZE, (unsigned int)TILE_SIZE);
+    errors += bench_driver();
+    errors += bench_desc();
+    errors += bench_queue();
+
+    printf("DMA queue benchmark finished with %d errors\n", errors);
+    return errors;
+}
@@ -0,0 +1,162 @@
+// Copyright 2026 Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: main.c
+// Author: agent
+// Date: 16/10/2026
+// Description: Benchmark of the DMA SDK tile streaming. A matrix is scaled tile
+//              by tile into a second one, first loading, processing and
+//              writing back each tile synchronously, then with
+//              dma_stream_run() overlapping the transfers with the processing.
+
+// System library headers
+#include <stdint.h>
+#include <stdio.h>
+
+// Custom library headers
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma_sdk.h"
+
+// Benchmark configuration
+#define ROWS 48
+#define COLS 60
+#define TILE_ROWS 8
+#define TILE_COLS 16
+#define NBUFS 2
+#define SCALE 3
+
+// Input and output matrices
+static int32_t mat_in[ROWS * COLS];
+static int32_t mat_out[ROWS * COLS];
+
+// Local tile buffers
+static int32_t in_bufs[NBUFS][TILE_ROWS * TILE_COLS];
+static int32_t out_bufs[NBUFS][TILE_ROWS * TILE_COLS];
+
+// Read the cycle counter
+static inline uint32_t cycles(void)
+{
+    uint32_t cyc;
+    CSR_READ(CSR_REG_MCYCLE, &cyc);
+    return cyc;
+}
+
+// Tile processing: scale each element
+static void scale_tile(const void *in, void *out, const dma_stream_tile_t *tile, void *arg)
+{
+    const int32_t *src = (const int32_t *)in;
+    int32_t *dst = (int32_t *)out;
+    int32_t scale = *(const int32_t *)arg;
+    for (uint32_t i = 0; i < tile->rows * tile->cols; i++) dst[i] = src[i] * scale;
+}
+
+// Check the output matrix
+static int check(const char *name)
+{
+    int errors = 0;
+    for (uint32_t i = 0; i < ROWS * COLS; i++) {
+        if (mat_out[i] != mat_in[i] * SCALE) errors++;
+    }
+    if (errors) printf("%s: %d errors\n", name, errors);
+    return errors;
+}
+
+// Synchronous flow: load, process and write back each tile in turn
+static int bench_sync(void)
+{
+    int32_t scale = SCALE;
+    dma_stream_tile_t tile;
+    uint32_t start, total;
+
+    for (uint32_t i = 0; i < ROWS * COLS; i++) mat_out[i] = 0;
+
+    start = cycles();
+    tile.index = 0;
+    for (tile.row = 0; tile.row < ROWS; tile.row += TILE_ROWS) {
+        tile.rows = ROWS - tile.row < TILE_ROWS ? ROWS - tile.row : TILE_ROWS;
+        for (tile.col = 0; tile.col < COLS; tile.col += TILE_COLS) {
+            tile.cols = COLS - tile.col < TILE_COLS ? COLS - tile.col : TILE_COLS;
+            for (uint32_t r = 0; r < tile.rows; r++) {
+                dma_copy((uint32_t)&in_bufs[0][r * tile.cols], (uint32_t)&mat_in[(tile.row + r) * COLS + tile.col],
+                         tile.cols, 0, DMA_DATA_TYPE_WORD, DMA_DATA_TYPE_WORD, 0);
+            }
+            scale_tile(in_bufs[0], out_bufs[0], &tile, &scale);
+            for (uint32_t r = 0; r < tile.rows; r++) {
+                dma_copy((uint32_t)&mat_out[(tile.row + r) * COLS + tile.col], (uint32_t)&out_bufs[0][r * tile.cols],
+                         tile.cols, 0, DMA_DATA_TYPE_WORD, DMA_DATA_TYPE_WORD, 0);
+            }
+            tile.index++;
+        }
+    }
+    total = cycles() - start;
+
+    printf("sync:   %7u cycles\n", (unsigned int)total);
+    return check("sync");
+}
+
+// Streaming flow
+static int bench_stream(void)
+{
+    int32_t scale = SCALE;
+    void *ins[NBUFS];
+    void *outs[NBUFS];
+    uint32_t start, total;
+
+    for (uint32_t i = 0; i < ROWS * COLS; i++) mat_out[i] = 0;
+    for (uint32_t b = 0; b < NBUFS; b++) {
+        ins[b] = in_bufs[b];
+        outs[b] = out_bufs[b];
+    }
+
+    dma_stream_t stream = {
+        .src = mat_in,
+        .dst = mat_out,
+        .rows = ROWS,
+        .cols = COLS,
+        .src_stride = COLS,
+        .dst_stride = COLS,
+        .tile_rows = TILE_ROWS,
+        .tile_cols = TILE_COLS,
+        .type = DMA_DATA_TYPE_WORD,
+        .in_bufs = ins,
+        .out_bufs = outs,
+        .n_bufs = NBUFS,
+        .ch_in = 0,
+        .ch_out = DMA_CH_NUM > 1 ? 1 : 0,
+        .compute = scale_tile,
+        .arg = &scale,
+    };
+
+    start = cycles();
+    if (dma_stream_run(&stream) != 0) {
+        printf("stream: configuration error\n");
+        return 1;
+    }
+    total = cycles() - start;
+
+    printf("stream: %7u cycles (%u channels)\n", (unsigned int)total, (unsigned int)(DMA_CH_NUM > 1 ? 2 : 1));
+    return check("stream");
+}
+
+// Main body
+// ---------
+int main(void)
+{
+    int errors = 0;
+
+    // Enable the cycle counter
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    for (uint32_t i = 0; i < ROWS * COLS; i++) mat_in[i] = (int32_t)(i * 7) - 1000;
+
+    dma_sdk_init();
+    printf("%ux%u words, %ux%u tiles\n", (unsigned int)ROWS, (unsigned int)COLS, (unsigned int)TILE_ROWS,
+           (unsigned int)TILE_COLS);
+    errors += bench_sync();
+    errors += bench_stream();
+
+    printf("DMA stream benchmark finished with %d errors\n", errors);
+    return errors;
+}
@@ -0,0 +1,141 @@
+// Copyright 2026 Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: main.c
+// Author: agent
+// Date: 16/10/2026
+// Description: Benchmark of the Q15 FFT SDK. For each size from 64 to 4096
+//              points, a tone is transformed with the radix-2 and radix-4
+//              complex FFTs and with the real FFT, reporting the cycles per
+//              point and checking that the energy lands in the tone bin.
+
+// System library headers
+#include <stdint.h>
+#include <stdio.h>
+
+// Custom library headers
+#include "csr.h"
+#include "fft_sdk.h"
+
+// Benchmark configuration
+#define MIN_LOG2 6
+#define MAX_LOG2 12
+#define AMPLITUDE 16384 // tone amplitude (0.5)
+#define TONE_BIN 5
+
+// In-place data buffer (complex or real samples)
+static fft_cq15_t data[1 << MAX_LOG2];
+
+// Read the cycle counter
+static inline uint32_t cycles(void)
+{
+    uint32_t cyc;
+    CSR_READ(CSR_REG_MCYCLE, &cyc);
+    return cyc;
+}
+
+static inline uint32_t mag(fft_cq15_t v)
+{
+    return (uint32_t)(v.re < 0 ? -v.re : v.re) + (uint32_t)(v.im < 0 ? -v.im : v.im);
+}
+
+// Complex tone exp(2*pi*i*TONE_BIN*n/N)
+static void gen_complex(uint32_t log2n)
+{
+    uint32_t n = 1u << log2n;
+    for (uint32_t i = 0; i < n; i++) {
+        fft_cq15_t w = fft_twiddle((TONE_BIN * i) & (n - 1), log2n);
+        data[i].re = (int16_t)((w.re * AMPLITUDE) >> 15);
+        data[i].im = (int16_t)((-w.im * AMPLITUDE) >> 15);
+    }
+}
+
+// Real tone cos(2*pi*TONE_BIN*n/N)
+static void gen_real(uint32_t log2n)
+{
+    uint32_t n = 1u << log2n;
+    int16_t *x = (int16_t *)data;
+    for (uint32_t i = 0; i < n; i++) {
+        fft_cq15_t w = fft_twiddle((TONE_BIN * i) & (n - 1), log2n);
+        x[i] = (int16_t)((w.re * AMPLITUDE) >> 15);
+    }
+}
+
+// Check that the tone bin holds the expected value and the others are small
+static int check(uint32_t bins, uint32_t expected)
+{
+    int errors = 0;
+    for (uint32_t k = 0; k < bins; k++) {
+        uint32_t m = mag(data[k]);
+        if (k == TONE_BIN) {
+            if (m < expected - expected / 16 || m > expected + expected / 16) errors++;
+        } else if (m > expected / 64) {
+            errors++;
+        }
+    }
+    return errors;
+}
+
+// Print cycles per point with one decimal digit
+static void report(const char *name, uint32_t total, uint32_t n)
+{
+    uint32_t cpp10 = (total * 10 + n / 2) / n;
+    printf("  %-7s %8u cycles, %4u.%u cycles/point\n", name, (unsigned int)total, (unsigned int)(cpp10 / 10),
+           (unsigned int)(cpp10 % 10));
+}
+
+// Main body
+// ---------
+int main(void)
+{
+    int errors = 0;
+    uint32_t start, total;
+
+    // Enable the cycle counter
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+#ifdef __riscv_xcvsimd
+    printf("Q15 FFT, packed-SIMD kernels\n");
+#else
+    printf("Q15 FFT, scalar kernels\n");
+#endif
+
+    for (uint32_t log2n = MIN_LOG2; log2n <= MAX_LOG2; log2n++) {
+        uint32_t n = 1u << log2n;
+        int err;
+        printf("N = %u\n", (unsigned int)n);
+
+        gen_complex(log2n);
+        start = cycles();
+        fft_cfft_radix2_q15(data, log2n);
+        total = cycles() - start;
+        report("radix2", total, n);
+        err = check(n, AMPLITUDE);
+        if (err) printf("  radix2: %d errors\n", err);
+        errors += err;
+
+        gen_complex(log2n);
+        start = cycles();
+        fft_cfft_q15(data, log2n);
+        total = cycles() - start;
+        report("radix4", total, n);
+        err = check(n, AMPLITUDE);
+        if (err) printf("  radix4: %d errors\n", err);
+        errors += err;
+
+        // Bins 1 to N/2-1 of a real tone hold half of its amplitude
+        gen_real(log2n);
+        start = cycles();
+        fft_rfft_q15((int16_t *)data, log2n);
+        total = cycles() - start;
+        report("real", total, n);
+        data[0].re = data[0].im = 0; // DC and Nyquist are not checked
+        err = check(n / 2, AMPLITUDE / 2);
+        if (err) printf("  real: %d errors\n", err);
+        errors += err;
+    }
+
+    printf("FFT benchmark finished with %d errors\n", errors);
+    return errors;
+}
@@ -0,0 +1,175 @@
+// Copyright 2026 Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: main.c
+// Author: agent
+// Date: 16/10/2026
+// Description: Benchmark of the W25Q BSP read cache. A table stored in flash
+//              only is read in small chunks, once sequentially and several
+//              times over a window that fits in the cache, first with
+//              w25q128jw_read() and then through the cache. Build with
+//              LINKER=flash_load; in simulation, also load the firmware into
+//              the SPI host flash (FLASH_DEVICE_IMAGE=<firmware>).
+
+// System library headers
+#include <stdint.h>
+#include <stdio.h>
+
+// Custom library headers
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "x-heep.h"
+#include "w25q128jw.h"
+#include "w25q128jw_cache.h"
+
+// In simulation, the BSP uses the SPI host connected to the device flash
+#if defined(TARGET_PYNQ_Z2) || defined(TARGET_ZCU104) || defined(TARGET_NEXYS_A7_100T)
+#define USE_SPI_FLASH
+#endif
+
+// Benchmark configuration
+#define TABLE_WORDS 1024
+#define CHUNK_BYTES 16
+#define LINE_SIZE 128
+#define CACHE_LINES 8
+#define WINDOW_BYTES 768 // reused window (fits in the cache)
+#define WINDOW_PASSES 4
+
+// Table values
+#define V(i) ((uint32_t)(i) * 2654435761u)
+#define X4(i) V(i), V((i) + 1), V((i) + 2), V((i) + 3)
+#define X16(i) X4(i), X4((i) + 4), X4((i) + 8), X4((i) + 12)
+#define X64(i) X16(i), X16((i) + 16), X16((i) + 32), X16((i) + 48)
+#define X256(i) X64(i), X64((i) + 64), X64((i) + 128), X64((i) + 192)
+
+#ifdef FLASH_LOAD
+// Table stored in flash only
+static uint32_t __attribute__((section(".xheep_data_flash_only"))) __attribute__((aligned(16)))
+table[TABLE_WORDS] = {X256(0), X256(256), X256(512), X256(768)};
+
+// Cache lines
+static uint32_t cache_buf[CACHE_LINES * LINE_SIZE / 4];
+
+// Flash reader under test
+typedef w25q_error_codes_t (*reader_t)(uint32_t addr, void *data, uint32_t length);
+
+// Read the cycle counter
+static inline uint32_t cycles(void)
+{
+    uint32_t cyc;
+    CSR_READ(CSR_REG_MCYCLE, &cyc);
+    return cyc;
+}
+
+// Read a region of the table in chunks and check the values
+static int read_region(reader_t read, uint32_t base, uint32_t offset, uint32_t len)
+{
+    uint32_t chunk[CHUNK_BYTES / 4];
+    int errors = 0;
+
+    for (uint32_t off = offset; off < offset + len; off += CHUNK_BYTES) {
+        if (read(base + off, chunk, CHUNK_BYTES) != FLASH_OK) return 1;
+        for (uint32_t i = 0; i < CHUNK_BYTES / 4; i++) {
+            if (chunk[i] != V(off / 4 + i)) errors++;
+        }
+    }
+    return errors;
+}
+
+// Sequential scan of the whole table
+static int bench_seq(const char *name, reader_t read, uint32_t base)
+{
+    uint32_t start, total;
+    int errors;
+
+    start = cycles();
+    errors = read_region(read, base, 0, TABLE_WORDS * 4);
+    total = cycles() - start;
+
+    printf("%-6s seq:   %8u cycles\n", name, (unsigned int)total);
+    if (errors) printf("%s seq: %d errors\n", name, errors);
+    return errors;
+}
+
+// Repeated scans of a window
+static int bench_reuse(const char *name, reader_t read, uint32_t base)
+{
+    uint32_t start, total;
+    int errors = 0;
+
+    start = cycles();
+    for (uint32_t p = 0; p < WINDOW_PASSES; p++) errors += read_region(read, base, 1024, WINDOW_BYTES);
+    total = cycles() - start;
+
+    printf("%-6s reuse: %8u cycles\n", name, (unsigned int)total);
+    if (errors) printf("%s reuse: %d errors\n", name, errors);
+    return errors;
+}
+
+// Print and clear the cache counters
+static void report_cache(void)
+{
+    w25q_cache_stats_t stats;
+    w25q128jw_cache_get_stats(&stats);
+    printf("       hits: %u, misses: %u, prefetches: %u, prefetch hits: %u\n", (unsigned int)stats.hits,
+           (unsigned int)stats.misses, (unsigned int)stats.prefetches, (unsigned int)stats.prefetch_hits);
+    w25q128jw_cache_reset_stats();
+}
+#endif // FLASH_LOAD
+
+// Main body
+// ---------
+int main(void)
+{
+#ifndef FLASH_LOAD
+    printf("This application is meant to run with the FLASH_LOAD linker script\n");
+    return 0;
+#else
+    int errors = 0;
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    // Enable the cycle counter
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    if (get_spi_flash_mode(&soc_ctrl) == SOC_CTRL_SPI_FLASH_MODE_SPIMEMIO) {
+        printf("This application cannot work with the memory mapped SPI flash\n");
+        return 0;
+    }
+
+#ifdef USE_SPI_FLASH
+    spi_host_t *spi = spi_flash;
+#else
+    spi_host_t *spi = spi_host1;
+#endif
+    if (w25q128jw_init(spi) != FLASH_OK) {
+        printf("Error initializing the SPI flash\n");
+        return 1;
+    }
+    dma_init(NULL);
+    if (w25q128jw_cache_init(cache_buf, LINE_SIZE, CACHE_LINES) != FLASH_OK) {
+        printf("Error initializing the flash cache\n");
+        return 1;
+    }
+
+    // Flash address of the table (the BSP addresses the flash from 0)
+    uint32_t base = (uint32_t)table - FLASH_MEM_START_ADDRESS;
+    printf("%u B table, %u B reads, %u x %u B cache lines\n", (unsigned int)(TABLE_WORDS * 4),
+           (unsigned int)CHUNK_BYTES, (unsigned int)CACHE_LINES, (unsigned int)LINE_SIZE);
+
+    errors += bench_seq("direct", w25q128jw_read, base);
+    errors += bench_seq("cache", w25q128jw_cache_read, base);
+    report_cache();
+
+    w25q128jw_cache_invalidate();
+    errors += bench_reuse("direct", w25q128jw_read, base);
+    errors += bench_reuse("cache", w25q128jw_cache_read, base);
+    report_cache();
+    w25q128jw_cache_sync();
+
+    printf("Flash cache benchmark finished with %d errors\n", errors);
+    return errors;
+#endif // FLASH_LOAD
+}
@@ -0,0 +1,150 @@
+// Copyright 2026 Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: main.c
+// Author: agent
+// Date: 16/10/2026
+// Description: Benchmark of the int8 GEMM SDK. For several matrix shapes,
+//              C = A * B is computed with a naive triple loop and with
+//              gemm_s8(), reporting MAC/cycle and checking the results. The
+//              operands are placed in the interleaved banks when the system
+//              has them. To compare bus topologies, regenerate the MCU with
+//              `make mcu-gen BUS=onetoM` or `make mcu-gen BUS=NtoM` (and
+//              MEMORY_BANKS_IL=<n>) and run the benchmark on each.
+
+// System library headers
+#include <stdint.h>
+#include <stdio.h>
+
+// Custom library headers
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "gemm_sdk.h"
+
+// Benchmark configuration
+#define MAX_N 32
+#define MAX_K 128
+#define MAX_A (32 * 64) // largest m * k of the shapes below
+#define MAX_B (128 * 32) // largest k * n of the shapes below
+#define MAX_C (32 * 32) // largest m * n of the shapes below
+
+typedef struct
+{
+    uint32_t m, n, k;
+} shape_t;
+
+static const shape_t shapes[] = {
+    {16, 16, 16}, {32, 32, 32}, {32, 8, 64}, {8, 32, 64}, {4, 32, 128}, {13, 7, 21},
+};
+
+#ifdef HAS_MEMORY_BANKS_IL
+#define OPERAND __attribute__((section(".xheep_data_interleaved"))) __attribute__((aligned(4)))
+#else
+#define OPERAND __attribute__((aligned(4)))
+#endif
+
+// Operands
+static int8_t OPERAND a[MAX_A];
+static int8_t OPERAND b[MAX_B];
+static int8_t OPERAND bp[GEMM_PACKED_B_SIZE(MAX_K, MAX_N)];
+static int32_t OPERAND c[MAX_C];
+static int32_t OPERAND c_ref[MAX_C];
+
+// Read the cycle counter
+static inline uint32_t cycles(void)
+{
+    uint32_t cyc;
+    CSR_READ(CSR_REG_MCYCLE, &cyc);
+    return cyc;
+}
+
+// Pseudo-random int8 values
+static uint32_t seed = 1;
+static int8_t rand8(void)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (int8_t)(seed >> 24);
+}
+
+// Reference: naive triple loop on row-major operands
+static void __attribute__((noinline)) gemm_naive(const shape_t *s, uint32_t lda)
+{
+    for (uint32_t i = 0; i < s->m; i++) {
+        for (uint32_t j = 0; j < s->n; j++) {
+            int32_t acc = 0;
+            for (uint32_t t = 0; t < s->k; t++) acc += a[i * lda + t] * b[t * s->n + j];
+            c_ref[i * s->n + j] = acc;
+        }
+    }
+}
+
+// Print MAC/cycle with two decimal digits
+static void report(const char *name, uint32_t total, uint32_t macs)
+{
+    uint32_t mpc100 = (macs * 100 + total / 2) / total;
+    printf("  %-6s %8u cycles, %2u.%02u MAC/cycle\n", name, (unsigned int)total, (unsigned int)(mpc100 / 100),
+           (unsigned int)(mpc100 % 100));
+}
+
+// Main body
+// ---------
+int main(void)
+{
+    int errors = 0;
+    uint32_t start, total;
+
+    // Enable the cycle counter
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+#ifdef __riscv_xcvsimd
+    printf("int8 GEMM, packed-SIMD kernels, ");
+#else
+    printf("int8 GEMM, scalar kernels, ");
+#endif
+#ifdef HAS_BUS_NTOM
+    printf("NtoM bus, ");
+#else
+    printf("onetoM bus, ");
+#endif
+#ifdef HAS_MEMORY_BANKS_IL
+    printf("interleaved operands\n");
+#else
+    printf("contiguous operands\n");
+#endif
+
+    for (uint32_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+        const shape_t *sh = &shapes[s];
+        uint32_t lda = GEMM_K_ALIGN(sh->k);
+        uint32_t macs = sh->m * sh->n * sh->k;
+        int err = 0;
+
+        for (uint32_t i = 0; i < sh->m * lda; i++) a[i] = rand8();
+        for (uint32_t i = 0; i < sh->k * sh->n; i++) b[i] = rand8();
+        printf("M = %u, N = %u, K = %u\n", (unsigned int)sh->m, (unsigned int)sh->n, (unsigned int)sh->k);
+
+        start = cycles();
+        gemm_naive(sh, lda);
+        total = cycles() - start;
+        report("naive", total, macs);
+
+        start = cycles();
+        gemm_s8_pack_b(b, sh->n, bp, sh->k, sh->n);
+        total = cycles() - start;
+        printf("  pack   %8u cycles\n", (unsigned int)total);
+
+        start = cycles();
+        if (gemm_s8(sh->m, sh->n, sh->k, a, lda, bp, c, sh->n) != 0) err++;
+        total = cycles() - start;
+        report("gemm", total, macs);
+
+        for (uint32_t i = 0; i < sh->m * sh->n; i++) {
+            if (c[i] != c_ref[i]) err++;
+        }
+        if (err) printf("  %d errors\n", err);
+        errors += err;
+    }
+
+    printf("GEMM benchmark finished with %d errors\n", errors);
+    return errors;
+}
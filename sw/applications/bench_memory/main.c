@@ -0,0 +1,172 @@
+// Copyright 2026 Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: main.c
+// Author: agent
+// Date: 16/10/2026
+// Description: Microbenchmark of memcpy(), memset(), memcmp() and memchr(),
+//              reporting cycles per byte for each size and alignment. The
+//              byte-by-byte loops are measured as a reference, and memcpy() and
+//              memset() are also measured with the DMA offload enabled.
+
+// System library headers
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Custom library headers
+#include "csr.h"
+#include "dma_sdk.h"
+#include "memory.h"
+
+// Benchmark configuration
+#define MAX_SIZE 4096
+#define DMA_THRESHOLD 256 // offload calls of at least 256 bytes
+
+static const uint32_t sizes[] = {4, 16, 64, 256, 1024, 4096};
+static const uint32_t src_offsets[] = {0, 0, 1, 3};
+static const uint32_t dst_offsets[] = {0, 1, 0, 2};
+
+// Buffers (with room for the misaligned offsets)
+static uint8_t src_buf[MAX_SIZE + 4] __attribute__((aligned(4)));
+static uint8_t dst_buf[MAX_SIZE + 4] __attribute__((aligned(4)));
+
+// Benchmarked functions
+typedef enum {
+    BENCH_MEMCPY,
+    BENCH_MEMSET,
+    BENCH_MEMCMP,
+    BENCH_MEMCHR,
+    BENCH_BYTE_MEMCPY,
+    BENCH_BYTE_MEMSET,
+} bench_func_t;
+
+static const char *bench_names[] = {
+    "memcpy", "memset", "memcmp", "memchr", "byte-memcpy", "byte-memset",
+};
+
+// Reference byte-by-byte implementations (as in the original libbase)
+static void __attribute__((noinline, optimize("no-tree-loop-distribute-patterns")))
+byte_memcpy(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) dst[i] = src[i];
+}
+
+static void __attribute__((noinline, optimize("no-tree-loop-distribute-patterns")))
+byte_memset(uint8_t *dst, uint8_t value, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) dst[i] = value;
+}
+
+// Run a function and return the elapsed cycles
+static uint32_t run(bench_func_t func, uint8_t *dst, uint8_t *src, uint32_t len)
+{
+    uint32_t start, end;
+    volatile uintptr_t sink;
+
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    switch (func) {
+    case BENCH_MEMCPY:
+        memcpy(dst, src, len);
+        break;
+    case BENCH_MEMSET:
+        memset(dst, 0xa5, len);
+        break;
+    case BENCH_MEMCMP:
+        sink = (uintptr_t)memcmp(dst, src, len);
+        break;
+    case BENCH_MEMCHR:
+        sink = (uintptr_t)memchr(src, 0xff, len);
+        break;
+    case BENCH_BYTE_MEMCPY:
+        byte_memcpy(dst, src, len);
+        break;
+    case BENCH_BYTE_MEMSET:
+        byte_memset(dst, 0xa5, len);
+        break;
+    }
+    CSR_READ(CSR_REG_MCYCLE, &end);
+    (void)sink;
+    return end - start;
+}
+
+// Check the result of the last run
+static int check(bench_func_t func, uint8_t *dst, uint8_t *src, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        switch (func) {
+        case BENCH_MEMCPY:
+        case BENCH_BYTE_MEMCPY:
+            if (dst[i] != src[i]) return 1;
+            break;
+        case BENCH_MEMSET:
+        case BENCH_BYTE_MEMSET:
+            if (dst[i] != 0xa5) return 1;
+            break;
+        default:
+            break;
+        }
+    }
+    return 0;
+}
+
+// Benchmark a function over all the sizes and alignments
+static int bench(bench_func_t func, const char *suffix)
+{
+    int errors = 0;
+    for (uint32_t a = 0; a < sizeof(src_offsets) / sizeof(src_offsets[0]); a++) {
+        for (uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            uint8_t *src = src_buf + src_offsets[a];
+            uint8_t *dst = dst_buf + dst_offsets[a];
+            uint32_t len = sizes[s];
+
+            // memcmp() compares equal buffers and memchr() misses the value,
+            // so that the whole region is scanned
+            for (uint32_t i = 0; i < len; i++) {
+                src[i] = (uint8_t)(i % 251);
+                dst[i] = func == BENCH_MEMCMP ? src[i] : 0;
+            }
+
+            uint32_t cycles = run(func, dst, src, len);
+            int err = check(func, dst, src, len);
+            errors += err;
+
+            // Cycles per byte, with two decimal digits
+            uint32_t cpb = cycles * 100 / len;
+            printf("%s%s src+%u dst+%u %u B: %u cycles, %u.%02u cycles/B%s\n", bench_names[func], suffix,
+                   (unsigned int)src_offsets[a], (unsigned int)dst_offsets[a], (unsigned int)len,
+                   (unsigned int)cycles, (unsigned int)(cpb / 100), (unsigned int)(cpb % 100),
+                   err ? " [ERROR]" : "");
+        }
+    }
+    return errors;
+}
+
+// Main body
+// ---------
+int main(void)
+{
+    int errors = 0;
+
+    // Enable the cycle counter
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    // CPU implementations
+    errors += bench(BENCH_BYTE_MEMCPY, "");
+    errors += bench(BENCH_MEMCPY, "");
+    errors += bench(BENCH_BYTE_MEMSET, "");
+    errors += bench(BENCH_MEMSET, "");
+    errors += bench(BENCH_MEMCMP, "");
+    errors += bench(BENCH_MEMCHR, "");
+
+    // DMA offload
+    dma_sdk_init();
+    dma_sdk_memory_offload(DMA_THRESHOLD);
+    errors += bench(BENCH_MEMCPY, "+dma");
+    errors += bench(BENCH_MEMSET, "+dma");
+    dma_sdk_memory_offload(0);
+
+    printf("Memory benchmark finished with %d errors\n", errors);
+    return errors;
+}
@@ -0,0 +1,145 @@
+// Copyright 2026 Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: main.c
+// Author: agent
+// Date: 16/10/2026
+// Description: Benchmark of the asynchronous UART transmission. The same
+//              burst of printf() calls is timed with the synchronous _write(),
+//              then with the ring drained by the TX watermark interrupt and by
+//              the DMA, reporting the cycles spent in printf() and until the
+//              ring is flushed. A last run with a small ring and the drop
+//              policy checks the overflow accounting.
+
+// System library headers
+#include <stdint.h>
+#include <stdio.h>
+
+// Custom library headers
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "rv_plic.h"
+#include "uart_sdk.h"
+
+// Benchmark configuration
+#define LINES 16
+#define RING_SIZE 1024
+#define SMALL_RING_SIZE 64
+#define DMA_CHANNEL 0
+
+#ifdef HAS_MEMORY_BANKS_IL
+#define OPERAND __attribute__((section(".xheep_data_interleaved"))) __attribute__((aligned(4)))
+#else
+#define OPERAND __attribute__((aligned(4)))
+#endif
+
+// Transmission ring
+static uint8_t OPERAND ring[RING_SIZE];
+
+// Results of a run
+typedef struct
+{
+    uint32_t print_max; // Longest printf() call
+    uint32_t print;     // Cycles spent in printf()
+    uint32_t total;     // Cycles until the output is transmitted
+    uint32_t bytes;     // Bytes printed
+} run_t;
+
+// Read the cycle counter
+static inline uint32_t cycles(void)
+{
+    uint32_t cyc;
+    CSR_READ(CSR_REG_MCYCLE, &cyc);
+    return cyc;
+}
+
+// Print a burst of lines, as a debug trace in a control loop would
+static void burst(run_t *run)
+{
+    uint32_t t0, t1, start = cycles();
+
+    run->print_max = 0;
+    run->print = 0;
+    run->bytes = 0;
+    for (int i = 0; i < LINES; i++) {
+        t0 = cycles();
+        int n = printf("trace %2d: state %08x, error %6d\n", i, (unsigned int)(i * 0x01010101u), i * -37);
+        t1 = cycles() - t0;
+        run->print += t1;
+        run->print_max = t1 > run->print_max ? t1 : run->print_max;
+        run->bytes += n > 0 ? n : 0;
+    }
+    uart_tx_flush();
+    run->total = cycles() - start;
+}
+
+// Print the results once the transmission is synchronous again
+static void report(const char *name, const run_t *run)
+{
+    printf("%-5s printf %7u cycles (max %6u), transmitted after %7u cycles\n", name, (unsigned int)run->print,
+           (unsigned int)run->print_max, (unsigned int)run->total);
+}
+
+int main(void)
+{
+    uart_tx_config_t cfg = {ring, RING_SIZE, UART_TX_DRAIN_IRQ, UART_TX_BLOCK, DMA_CHANNEL};
+    uart_tx_stats_t stats;
+    run_t sync, irq, dma, drop;
+    int errors = 0;
+
+    // Enable the cycle counter and the PLIC handler table
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+    plic_Init();
+
+    printf("UART TX, %u lines, %u-byte ring\n", (unsigned int)LINES, (unsigned int)RING_SIZE);
+
+    // Synchronous transmission
+    burst(&sync);
+
+    // Ring drained by the interrupt handler
+    if (uart_tx_init(&cfg) != 0) {
+        printf("IRQ drain: configuration error\n");
+        return 1;
+    }
+    burst(&irq);
+    uart_tx_stats(&stats);
+    uart_tx_disable();
+    if (stats.queued != irq.bytes || stats.dropped != 0) errors++;
+
+    // Ring drained by the DMA
+    cfg.drain = UART_TX_DRAIN_DMA;
+    if (uart_tx_init(&cfg) != 0) {
+        printf("DMA drain: configuration error\n");
+        return 1;
+    }
+    burst(&dma);
+    uart_tx_stats(&stats);
+    uart_tx_disable();
+    if (stats.queued != dma.bytes || stats.dropped != 0) errors++;
+
+    report("sync", &sync);
+    report("irq", &irq);
+    report("dma", &dma);
+    printf("ring high water %u bytes\n", (unsigned int)stats.high_water);
+
+    // Small ring dropping what does not fit
+    cfg.size = SMALL_RING_SIZE;
+    cfg.drain = UART_TX_DRAIN_IRQ;
+    cfg.overflow = UART_TX_DROP;
+    if (uart_tx_init(&cfg) != 0) {
+        printf("drop: configuration error\n");
+        return 1;
+    }
+    burst(&drop);
+    uart_tx_stats(&stats);
+    uart_tx_disable();
+    printf("\n");
+    if (stats.queued + stats.dropped != drop.bytes || stats.dropped == 0) errors++;
+
+    report("drop", &drop);
+    printf("%u bytes queued, %u dropped\n", (unsigned int)stats.queued, (unsigned int)stats.dropped);
+
+    printf("UART TX benchmark finished with %d errors\n", errors);
+    return errors;
+}
@@ -0,0 +1,75 @@
+// Copyright 2026 Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: main.c
+// Author: agent
+// Date: 16/10/2026
+// Description: Write a pattern to sparse pages of the first external slave,
+//              then read it back and check it. The simulation can be saved at
+//              ext_slave_checkpoint() and restored (see the --checkpoint option
+//              of util/regression.py), so that the check runs on the restored
+//              memory of the slave model. Requires ext_xbar_slaves in
+//              config/gr-heep-cfg.hjson.
+
+// System library headers
+#include <stdint.h>
+#include <stdio.h>
+
+// Custom library headers
+#include "gr_heep.h"
+
+// Test configuration
+#define PAGE_SIZE 4096
+#define NPAGES 4
+#define WORDS_PER_PAGE 16
+
+// Pattern word of the given page and index
+static inline uint32_t pattern(uint32_t page, uint32_t i)
+{
+    return (page << 16 | i) * 0x9E3779B1;
+}
+
+// Checkpoint marker (not inlined, so that its symbol can trigger the save)
+void __attribute__((noinline)) ext_slave_checkpoint(void)
+{
+    asm volatile("" ::: "memory");
+}
+
+// Main body
+// ---------
+int main(void)
+{
+#if EXT_XBAR_NSLAVE > 0
+    volatile uint32_t *ext = (volatile uint32_t *)EXT_SLAVE_START_ADDRESS;
+    uint32_t errors = 0;
+
+    // Write the first words of every other page, leaving holes in between
+    for (uint32_t p = 0; p < NPAGES; p++) {
+        for (uint32_t i = 0; i < WORDS_PER_PAGE; i++) {
+            ext[(2 * p * PAGE_SIZE) / 4 + i] = pattern(p, i);
+        }
+    }
+    printf("Pattern written to %d pages\n", NPAGES);
+
+    ext_slave_checkpoint();
+
+    // Check the pattern and the holes (never written, hence zero)
+    for (uint32_t p = 0; p < NPAGES; p++) {
+        for (uint32_t i = 0; i < WORDS_PER_PAGE; i++) {
+            if (ext[(2 * p * PAGE_SIZE) / 4 + i] != pattern(p, i)) errors++;
+            if (ext[((2 * p + 1) * PAGE_SIZE) / 4 + i] != 0) errors++;
+        }
+    }
+    if (errors) {
+        printf("External slave check failed: %u errors\n", (unsigned int)errors);
+        return 1;
+    }
+    printf("External slave check passed\n");
+    return 0;
+#else
+    // Nothing to check (no checkpoint is saved either)
+    printf("No external slaves (ext_xbar_slaves in config/gr-heep-cfg.hjson): skipped\n");
+    return 0;
+#endif
+}
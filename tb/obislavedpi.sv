@@ -0,0 +1,84 @@
+// Copyright 2026 EPFL and Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: obislavedpi.sv
+// Author: agent
+// Date: 16/10/2026
+// Description: OBI slave for Verilator. The slave (sparse memory and
+//              attached C++ device models) is modeled in C++
+//              (tb/verilator/tb_ext_slave.cpp) and evaluated on every rising
+//              edge of the clock. The grant and the response are registered.
+//              NOTE: ext_xbar keeps one request in flight per master and
+//              forwards a response to every master waiting on the slave, so
+//              more than one outstanding request (EXTSLAVE_DEPTH) is only
+//              safe when a single master accesses the slave.
+
+module obislavedpi #(
+    parameter string       NAME = "ext_slave",
+    parameter int unsigned IDX  = 0           // the model is named <NAME>_<IDX>
+) (
+    input  logic               clk_i,
+    input  logic               rst_ni,
+    input  obi_pkg::obi_req_t  req_i,
+    output obi_pkg::obi_resp_t resp_o
+);
+  import "DPI-C" function int extslavedpi_create(
+    input string name,
+    input int    gnt_latency,
+    input int    rvalid_latency,
+    input int    depth
+  );
+
+  import "DPI-C" function void extslavedpi_close(input int id);
+
+  import "DPI-C" function void obislavedpi_eval(
+    input  int       id,
+    input  bit       rst_n,
+    input  bit       req,
+    input  bit       we,
+    input  bit [3:0] be,
+    input  int       addr,
+    input  int       wdata,
+    output bit       gnt,
+    output bit       rvalid,
+    output int       rdata
+  );
+
+  // Model index (an index rather than a chandle, so that checkpoints can be
+  // restored in another process)
+  int id = -1;
+  string name;
+
+  // Configuration, overridden through the `EXTSLAVE_GNT` (wait states before
+  // each grant), `EXTSLAVE_RVALID` (cycles from the grant to the response) and
+  // `EXTSLAVE_DEPTH` (outstanding requests) plusargs, or their
+  // `EXTSLAVE_<...>_<name>` variants for a single slave.
+  int gnt_latency = 0;
+  int rvalid_latency = 1;
+  int depth = 1;
+
+  initial begin
+    name = $sformatf("%s_%0d", NAME, IDX);
+    void'($value$plusargs("EXTSLAVE_GNT=%d", gnt_latency));
+    void'($value$plusargs("EXTSLAVE_RVALID=%d", rvalid_latency));
+    void'($value$plusargs("EXTSLAVE_DEPTH=%d", depth));
+    void'($value$plusargs({"EXTSLAVE_GNT_", name, "=%d"}, gnt_latency));
+    void'($value$plusargs({"EXTSLAVE_RVALID_", name, "=%d"}, rvalid_latency));
+    void'($value$plusargs({"EXTSLAVE_DEPTH_", name, "=%d"}, depth));
+    id = extslavedpi_create(name, gnt_latency, rvalid_latency, depth);
+  end
+
+  final begin
+    extslavedpi_close(id);
+  end
+
+  bit gnt, rvalid;
+  int rdata;
+
+  always_ff @(posedge clk_i) begin
+    obislavedpi_eval(id, rst_ni, req_i.req, req_i.we, req_i.be, req_i.addr, req_i.wdata, gnt, rvalid,
+                     rdata);
+    resp_o <= '{gnt: gnt, rvalid: rvalid, rdata: rdata};
+  end
+endmodule
@@ -0,0 +1,69 @@
+// Copyright 2026 EPFL and Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: regslavedpi.sv
+// Author: agent
+// Date: 16/10/2026
+// Description: Register interface slave for Verilator, modeled in C++
+//              (tb/verilator/tb_ext_slave.cpp) like obislavedpi. The ready
+//              signal is asserted EXTSLAVE_GNT + EXTSLAVE_RVALID cycles after
+//              the request.
+
+module regslavedpi #(
+    parameter string NAME = "ext_periph"
+) (
+    input  logic              clk_i,
+    input  logic              rst_ni,
+    input  reg_pkg::reg_req_t req_i,
+    output reg_pkg::reg_rsp_t rsp_o
+);
+  import "DPI-C" function int extslavedpi_create(
+    input string name,
+    input int    gnt_latency,
+    input int    rvalid_latency,
+    input int    depth
+  );
+
+  import "DPI-C" function void extslavedpi_close(input int id);
+
+  import "DPI-C" function void regslavedpi_eval(
+    input  int       id,
+    input  bit       rst_n,
+    input  bit       valid,
+    input  bit       write,
+    input  bit [3:0] wstrb,
+    input  int       addr,
+    input  int       wdata,
+    output bit       ready,
+    output int       rdata
+  );
+
+  // Model index (see obislavedpi)
+  int id = -1;
+
+  // Configuration, overridden through the `EXTSLAVE_GNT_<name>` and
+  // `EXTSLAVE_RVALID_<name>` plusargs (the defaults of the memory slaves do
+  // not apply)
+  int gnt_latency = 0;
+  int rvalid_latency = 1;
+
+  initial begin
+    void'($value$plusargs({"EXTSLAVE_GNT_", NAME, "=%d"}, gnt_latency));
+    void'($value$plusargs({"EXTSLAVE_RVALID_", NAME, "=%d"}, rvalid_latency));
+    id = extslavedpi_create(NAME, gnt_latency, rvalid_latency, 1);
+  end
+
+  final begin
+    extslavedpi_close(id);
+  end
+
+  bit ready;
+  int rdata;
+
+  always_ff @(posedge clk_i) begin
+    regslavedpi_eval(id, rst_ni, req_i.valid, req_i.write, req_i.wstrb, req_i.addr, req_i.wdata, ready,
+                     rdata);
+    rsp_o <= '{error: 1'b0, ready: ready, rdata: rdata};
+  end
+endmodule
@@ -0,0 +1,74 @@
+// Copyright 2026 EPFL and Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: spiflashdpi.sv
+// Author: agent
+// Date: 16/10/2026
+// Description: W25Q128JW SPI flash emulator for Verilator. The flash is
+//              modeled in C++ (tb/verilator/tb_flash.cpp) and evaluated on
+//              every edge of the chip select and clock.
+
+module spiflashdpi #(
+    parameter string NAME = "flash"
+) (
+    input logic csb,
+    input logic clk,
+    inout wire  io0,
+    inout wire  io1,
+    inout wire  io2,
+    inout wire  io3
+);
+  import "DPI-C" function chandle spiflashdpi_create(
+    input string name,
+    input string image,
+    input int    dummy_cycles,
+    input int    prog_cycles,
+    input int    erase_cycles
+  );
+
+  import "DPI-C" function void spiflashdpi_close(input chandle ctx);
+
+  import "DPI-C" function byte spiflashdpi_eval(
+    input chandle ctx,
+    input bit     csb,
+    input bit     clk,
+    input byte    io
+  );
+
+  chandle ctx;
+
+  // Configuration, overridden through the `SPIFLASH_IMAGE_<name>` (image
+  // file, empty: erased flash), `SPIFLASH_DUMMY_<name>` (fast read dummy
+  // cycles), `SPIFLASH_PROG_<name>` and `SPIFLASH_ERASE_<name>` (page program
+  // and sector erase busy time in system clock cycles) plusargs.
+  string image = "";
+  int dummy_cycles = 8;
+  int prog_cycles = 0;
+  int erase_cycles = 0;
+
+  initial begin
+    void'($value$plusargs({"SPIFLASH_IMAGE_", NAME, "=%s"}, image));
+    void'($value$plusargs({"SPIFLASH_DUMMY_", NAME, "=%d"}, dummy_cycles));
+    void'($value$plusargs({"SPIFLASH_PROG_", NAME, "=%d"}, prog_cycles));
+    void'($value$plusargs({"SPIFLASH_ERASE_", NAME, "=%d"}, erase_cycles));
+    ctx = spiflashdpi_create(NAME, image, dummy_cycles, prog_cycles, erase_cycles);
+  end
+
+  final begin
+    spiflashdpi_close(ctx);
+    ctx = null;
+  end
+
+  // Output enables (7:4) and values (3:0)
+  logic [7:0] io_out = 8'h00;
+
+  always @(posedge clk or negedge clk or posedge csb or negedge csb) begin
+    io_out <= spiflashdpi_eval(ctx, csb, clk, {4'b0, io3, io2, io1, io0});
+  end
+
+  assign io0 = io_out[4] ? io_out[0] : 1'bz;
+  assign io1 = io_out[5] ? io_out[1] : 1'bz;
+  assign io2 = io_out[6] ? io_out[2] : 1'bz;
+  assign io3 = io_out[7] ? io_out[3] : 1'bz;
+endmodule
@@ -19,7 +19,18 @@ module tb_system #(
 
     // Exit signals
     inout logic        exit_valid_o,
-    inout logic [31:0] exit_value_o
+    inout logic [31:0] exit_value_o,
+
+    // Retired instruction probe
+    inout logic        instr_retired_o,
+    inout logic [31:0] instr_pc_o,
+
+    // GPIO probe
+    inout logic [31:0] gpio_o,
+
+    // Core profiling probe
+    inout logic [31:0] prof_pc_o,
+    inout logic [15:0] prof_events_o
 );
   // Include testbench utils
   `include "tb_util.svh"
@@ -53,6 +64,12 @@ module tb_system #(
   // GPIO
   wire                          clk_div;
 
+  // External bus slaves and peripherals
+  obi_pkg::obi_req_t  [gr_heep_pkg::ExtXbarNSlaveRnd-1:0] ext_slave_req;
+  obi_pkg::obi_resp_t [gr_heep_pkg::ExtXbarNSlaveRnd-1:0] ext_slave_resp;
+  reg_pkg::reg_req_t                                       ext_periph_req;
+  reg_pkg::reg_rsp_t                                       ext_periph_rsp;
+
   // UART DPI emulator
   uartdpi #(
       .BAUD('d256000),
@@ -66,7 +83,29 @@ module tb_system #(
   );
 
   // SPI flash emulator
-`ifndef VERILATOR
+`ifdef VERILATOR
+  spiflashdpi #(
+      .NAME("flash_boot")
+  ) u_flash_boot (
+      .csb(spi_flash_csb[0]),
+      .clk(spi_flash_sck),
+      .io0(spi_flash_sd_io[0]),
+      .io1(spi_flash_sd_io[1]),
+      .io2(spi_flash_sd_io[2]),
+      .io3(spi_flash_sd_io[3])
+  );
+
+  spiflashdpi #(
+      .NAME("flash_device")
+  ) u_flash_device (
+      .csb(spi_csb[0]),
+      .clk(spi_sck),
+      .io0(spi_sd_io[0]),
+      .io1(spi_sd_io[1]),
+      .io2(spi_sd_io[2]),
+      .io3(spi_sd_io[3])
+  );
+`else
   spiflash u_flash_boot (
       .csb(spi_flash_csb[0]),
       .clk(spi_flash_sck),
@@ -86,6 +125,37 @@ module tb_system #(
   );
 `endif  /* VERILATOR */
 
+  // External bus slave and peripheral models
+`ifdef VERILATOR
+  for (genvar i = 0; i < gr_heep_pkg::ExtXbarNSlave; i++) begin : gen_ext_slave
+    obislavedpi #(
+        .NAME("ext_slave"),
+        .IDX (i)
+    ) u_ext_slave (
+        .clk_i (clk_i),
+        .rst_ni(rst_ni),
+        .req_i (ext_slave_req[i]),
+        .resp_o(ext_slave_resp[i])
+    );
+  end
+  if (gr_heep_pkg::ExtXbarNSlave == 0) begin : gen_no_ext_slave
+    assign ext_slave_resp = '0;
+  end
+
+  regslavedpi #(
+      .NAME("ext_periph")
+  ) u_ext_periph (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+      .req_i (ext_periph_req),
+      .rsp_o (ext_periph_rsp)
+  );
+`else
+  // Not modeled: accesses to the external address ranges never complete
+  assign ext_slave_resp = '0;
+  assign ext_periph_rsp = '0;
+`endif  /* VERILATOR */
+
   gpio_cnt #(
       .CntMax(32'd16)
   ) u_test_gpio (
@@ -98,6 +168,10 @@ module tb_system #(
   // DUT
   // ---
   gr_heep_top u_gr_heep_top (
+      .ext_slave_req_o     (ext_slave_req),
+      .ext_slave_resp_i    (ext_slave_resp),
+      .ext_periph_req_o    (ext_periph_req),
+      .ext_periph_rsp_i    (ext_periph_rsp),
       .rst_ni              (rst_ni),
       .boot_select_i       (boot_select_i),
       .execute_from_flash_i(execute_from_flash_i),
@@ -163,4 +237,106 @@ module tb_system #(
 
   // Exit value
   assign exit_value_o[31:1] = u_gr_heep_top.u_core_v_mini_mcu.exit_value_o[31:1];
+
+  // Retired instruction probe (used by the C++ testbench for symbol triggers)
+  // NOTE: the retired instruction event of the core is registered one cycle
+  // after the instruction leaves the ID stage, so the ID stage PC is delayed by
+  // one cycle to line up with it. Only the CV32E40PX exposes them: with other
+  // cores, the probe is tied off and symbol triggers never fire.
+  if (core_v_mini_mcu_pkg::CpuType == core_v_mini_mcu_pkg::cv32e40px) begin : gen_instr_probe
+`define TB_CORE u_gr_heep_top.u_core_v_mini_mcu.cpu_subsystem_i.gen_cv32e40px.cv32e40px_top_i.core_i
+    logic [31:0] instr_pc_q;
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+      if (!rst_ni) instr_pc_q <= '0;
+      else instr_pc_q <= `TB_CORE.pc_id;
+    end
+    assign instr_retired_o = `TB_CORE.mhpmevent_minstret;
+    assign instr_pc_o      = instr_pc_q;
+`undef TB_CORE
+  end else begin : gen_no_instr_probe
+    assign instr_retired_o = 1'b0;
+    assign instr_pc_o      = '0;
+  end
+
+  // GPIO probe (used by the C++ testbench for waveform triggers)
+  assign gpio_o = gpio;
+
+  // Core profiling probe (used by the C++ testbench profiler)
+  // NOTE: the core performance events are registered one cycle after the
+  // instruction leaves the ID stage, so the ID stage PC and the other events are
+  // delayed by one cycle to line up with them. The bit order must match
+  // prof_event_t in tb/verilator/tb_profiler.hh. Only the CV32E40PX exposes
+  // them: with other cores, the probe is tied off and all the cycles are
+  // attributed to [unknown].
+  if (core_v_mini_mcu_pkg::CpuType == core_v_mini_mcu_pkg::cv32e40px) begin : gen_prof_probe
+`define TB_CORE u_gr_heep_top.u_core_v_mini_mcu.cpu_subsystem_i.gen_cv32e40px.cv32e40px_top_i.core_i
+    logic [31:0] prof_pc_q;
+    logic prof_sleep_q, prof_dmem_stall_q;
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+      if (!rst_ni) begin
+        prof_pc_q         <= '0;
+        prof_sleep_q      <= 1'b0;
+        prof_dmem_stall_q <= 1'b0;
+      end else begin
+        prof_pc_q         <= `TB_CORE.pc_id;
+        prof_sleep_q      <= u_gr_heep_top.u_core_v_mini_mcu.core_sleep;
+        prof_dmem_stall_q <= u_gr_heep_top.u_core_v_mini_mcu.core_data_req.req &
+                             ~u_gr_heep_top.u_core_v_mini_mcu.core_data_resp.gnt;
+      end
+    end
+    assign prof_pc_o = prof_pc_q;
+    assign prof_events_o = {
+      3'b000,
+      prof_dmem_stall_q,
+      prof_sleep_q,
+      `TB_CORE.mhpmevent_pipe_stall,
+      `TB_CORE.mhpmevent_ld_stall,
+      `TB_CORE.mhpmevent_imiss,
+      `TB_CORE.mhpmevent_jr_stall,
+      `TB_CORE.mhpmevent_compressed,
+      `TB_CORE.mhpmevent_branch_taken,
+      `TB_CORE.mhpmevent_branch,
+      `TB_CORE.mhpmevent_jump,
+      `TB_CORE.mhpmevent_store,
+      `TB_CORE.mhpmevent_load,
+      `TB_CORE.mhpmevent_minstret
+    };
+`undef TB_CORE
+  end else begin : gen_no_prof_probe
+    assign prof_pc_o     = '0;
+    assign prof_events_o = '0;
+  end
+
+`ifdef VERILATOR
+  // UART DPI context access (used by the C++ testbench to restore checkpoints)
+  export "DPI-C" task tb_uart_get_ctx;
+  export "DPI-C" task tb_uart_set_ctx;
+
+  task tb_uart_get_ctx;
+    output chandle ctx;
+    ctx = u_uartdpi.ctx;
+  endtask
+
+  task tb_uart_set_ctx;
+    input chandle ctx;
+    u_uartdpi.ctx = ctx;
+  endtask
+
+  // SPI flash DPI context access (0: boot flash, 1: device flash)
+  export "DPI-C" task tb_flash_get_ctx;
+  export "DPI-C" task tb_flash_set_ctx;
+
+  task tb_flash_get_ctx;
+    input int idx;
+    output chandle ctx;
+    ctx = idx == 0 ? u_flash_boot.ctx : u_flash_device.ctx;
+  endtask
+
+  task tb_flash_set_ctx;
+    input int idx;
+    input chandle ctx;
+    if (idx == 0) u_flash_boot.ctx = ctx;
+    else u_flash_device.ctx = ctx;
+  endtask
+`endif  /* VERILATOR */
 endmodule
@@ -13,6 +13,7 @@
 #include <getopt.h>
 #include <stdint.h>
 #include <errno.h>
+#include <chrono>
 
 // Verilator libraries
 #include <verilated.h>
@@ -21,6 +22,15 @@
 
 // User libraries
 #include "tb_macros.hh"
+#include "tb_elf.hh"
+#include "tb_checkpoint.hh"
+#include "tb_loader.hh"
+#include "tb_trigger.hh"
+#include "tb_trace.hh"
+#include "tb_profiler.hh"
+#include "tb_flash.hh"
+#include "tb_dlog.hh"
+#include "tb_ext_slave.hh"
 #include "Vtb_system.h"
 
 // Defines
@@ -30,8 +40,6 @@
 #define RESET_CYCLES 200
 #define POST_RESET_CYCLES 50
 #define MAX_SIM_CYCLES 2e6
-#define BOOT_SEL 0 // 0: JTAG boot
-#define EXEC_FROM_FLASH 0 // 0: do not execute from flash
 #define RUN_CYCLES 500
 #define TB_HIER_NAME "TOP.tb_system"
 
@@ -40,7 +48,8 @@
 enum boot_mode_e {
     BOOT_MODE_JTAG = 0,
     BOOT_MODE_FLASH = 1,
-    BOOT_MODE_FORCE = 2
+    BOOT_MODE_FORCE = 2,
+    BOOT_MODE_CHECKPOINT = 3 // resume from a saved checkpoint
 };
 
 // Function prototypes
@@ -53,16 +62,30 @@ void initDut(Vtb_system *dut, uint8_t boot_mode, uint8_t exec_from_flash);
 
 // Generate clock and reset
 void clkGen(Vtb_system *dut);
-void rstDut(Vtb_system *dut, uint8_t gen_waves, VerilatedFstC *trace);
+void rstDut(Vtb_system *dut, uint8_t gen_waves, TbTracer *trace);
 
 // Run simulation for the specififed number of cycles
-void runCycles(unsigned int ncycles, Vtb_system *dut, uint8_t gen_waves, VerilatedFstC *trace);
+void runCycles(unsigned int ncycles, Vtb_system *dut, uint8_t gen_waves, TbTracer *trace);
+
+// Close the waveform file on exit
+void closeTrace();
+
+// Print the simulation throughput (simulated cycles per wall-clock second) and
+// return the elapsed wall-clock time in seconds
+double printThroughput(vluint64_t ncycles, std::chrono::steady_clock::time_point wall_start);
+
+// Write the simulation results to a JSON file (e.g., for the regression runner)
+bool writeStats(const std::string &file, Vtb_system *dut, bool max_cycles_reached, vluint64_t ncycles, double wall_time);
 
 // Global variables
 // ----------------
 // Testbench logger
 TbLogger logger;
 vluint64_t sim_cycles = 0;
+vluint64_t sim_instret = 0;
+TbTracer *trace = NULL;
+TbProfiler *profiler = NULL;
+TbDlog *dlog = NULL;
 
 int main(int argc, char *argv[])
 {
@@ -93,6 +116,33 @@ int main(int argc, char *argv[])
             printf("  -l, --log_level=LOG_LEVEL\tSet the log level\n");
             printf("  -t, --trace=[true/false]\t\tGenerate waveforms\n");
             printf("  -q, --no_err=[true/false]\t\t\tAlways return 0\n");
+            printf("Plusargs:\n");
+            printf("  +firmware=FILE\t\t\tFirmware HEX file to load\n");
+            printf("  +firmware_elf=FILE\t\t\tFirmware ELF file (default: FILE.elf)\n");
+            printf("  +fast_load=[0/1]\t\t\tWrite the firmware directly into the SRAM arrays (default: 1)\n");
+            printf("  +boot_mode=[jtag/flash/force]\tBoot mode\n");
+            printf("  +exec_from_flash=[0/1]\t\tExecute the firmware from flash (flash boot mode only)\n");
+            printf("  +SPIFLASH_IMAGE_flash_boot=FILE\tBoot flash image (default with flash boot: firmware file)\n");
+            printf("  +SPIFLASH_DUMMY_flash_boot=N\tBoot flash fast read dummy cycles (default: %d)\n", TB_FLASH_DUMMY_CYCLES);
+            printf("  +SPIFLASH_PROG_flash_boot=N\tBoot flash page program time in cycles (default: 0)\n");
+            printf("  +SPIFLASH_ERASE_flash_boot=N\tBoot flash sector erase time in cycles (default: 0)\n");
+            printf("  +EXTSLAVE_GNT=N\t\t\tExternal slaves wait states before each grant (default: 0)\n");
+            printf("  +EXTSLAVE_RVALID=N\t\t\tExternal slaves cycles from grant to response (default: 1)\n");
+            printf("  +EXTSLAVE_DEPTH=N\t\t\tExternal slaves outstanding requests (default: 1)\n");
+            printf("  +EXTSLAVE_<GNT/RVALID/DEPTH>_<NAME>=N\tSame, for the ext_slave_<N> or ext_periph model only\n");
+            printf("  +max_cycles=N\t\t\tMaximum number of simulated cycles\n");
+            printf("  +trace_start=[CYCLE/SYMBOL]\tStart dumping waveforms at the given cycle or firmware symbol\n");
+            printf("  +trace_stop=[CYCLE/SYMBOL]\t\tStop dumping waveforms at the given cycle or firmware symbol\n");
+            printf("  +trace_gpio=N\t\t\tOnly dump waveforms while GPIO N is high\n");
+            printf("  +trace_ring=N\t\t\tOnly keep the waveforms of the last N cycles\n");
+            printf("  +save_checkpoint=[CYCLE/SYMBOL]\tSave a checkpoint at the given cycle or firmware symbol\n");
+            printf("  +checkpoint_file=FILE\t\tCheckpoint file to save (default: %s)\n", CHECKPOINT_FILENAME);
+            printf("  +checkpoint_stop=[0/1]\t\tTerminate the simulation after saving the checkpoint\n");
+            printf("  +restore_checkpoint=FILE\t\tRestore a checkpoint instead of resetting and loading the firmware\n");
+            printf("  +stats_file=FILE\t\t\tWrite exit value, cycles and wall-clock time to a JSON file\n");
+            printf("  +profile=PREFIX\t\t\tProfile the firmware into PREFIX.txt (flat) and PREFIX.folded (call stacks)\n");
+            printf("  +profile_interval=N\t\tProfiler sampling interval in cycles (default: 1)\n");
+            printf("  +dlog=FILE\t\t\tDecode the deferred-format log of the firmware into FILE ('-': stdout)\n");
             exit(0);
             break;
         case 'l':
@@ -120,9 +170,29 @@ int main(int argc, char *argv[])
     // ------------------------------------------
     std::string boot_mode_str;
     unsigned int boot_mode = 0;
+    bool exec_from_flash = false;
+    std::string flash_image;
     std::string firmware_file;
     std::string max_cycles_str;
     unsigned long max_cycles = MAX_SIM_CYCLES;
+    std::string firmware_elf;
+    TbElf elf;
+    std::string ckpt_file;
+    std::string restore_ckpt_file;
+    tb_trigger_t ckpt_trig;
+    bool ckpt_stop = false;
+    bool ckpt_saved = false;
+    tb_trigger_t trace_start;
+    tb_trigger_t trace_stop;
+    std::string trace_gpio_str;
+    std::string trace_ring_str;
+    std::string stats_file;
+    std::string profile_prefix;
+    std::string profile_interval_str;
+    std::string dlog_file;
+    bool max_cycles_reached = false;
+    bool fast_load = true;
+    TbLoader loader;
 
     // Boot mode
     boot_mode_str = getCmdOption(argc, argv, "+boot_mode=");
@@ -138,18 +208,42 @@ int main(int argc, char *argv[])
         boot_mode = BOOT_MODE_JTAG;
     }
 
+    // Execute from flash (the boot code jumps to the memory-mapped flash)
+    exec_from_flash = getCmdOption(argc, argv, "+exec_from_flash=") == "1";
+    if (exec_from_flash && boot_mode != BOOT_MODE_FLASH) {
+        TB_WARN("Execution from flash requires the flash boot mode: executing from RAM");
+        exec_from_flash = false;
+    }
+
+    // Checkpoint to restore (firmware and reset are skipped)
+    restore_ckpt_file = getCmdOption(argc, argv, "+restore_checkpoint=");
+
     // Firmware HEX file
     firmware_file = getCmdOption(argc, argv, "+firmware=");
-    if (firmware_file.empty()) {
+    if (firmware_file.empty() && restore_ckpt_file.empty()) {
         TB_ERR("No firmware file specified");
         exit(EXIT_FAILURE);
-    } else {
+    } else if (!firmware_file.empty()) {
         // Check if file exists
         FILE *fp = fopen(firmware_file.c_str(), "r");
         if (fp == NULL) {
             TB_ERR("Cannot open firmware file '%s': %s", firmware_file.c_str(), strerror(errno));
             exit(EXIT_FAILURE);
         }
+        fclose(fp);
+    }
+
+    // Boot flash image (default: the firmware itself when booting from flash)
+    flash_image = getCmdOption(argc, argv, "+SPIFLASH_IMAGE_flash_boot=");
+
+    // Firmware loader (fast: write populated words straight into the SRAM
+    // arrays; slow: $readmemh and per-word DPI writes)
+    fast_load = getCmdOption(argc, argv, "+fast_load=") != "0";
+
+    // Firmware ELF file (used to resolve symbols)
+    firmware_elf = getCmdOption(argc, argv, "+firmware_elf=");
+    if (firmware_elf.empty() && !firmware_file.empty()) {
+        firmware_elf = elfFromHex(firmware_file);
     }
 
     // Max simulation cycles
@@ -158,14 +252,61 @@ int main(int argc, char *argv[])
         max_cycles = std::stoul(max_cycles_str);
     }
 
+    // Checkpoint to save
+    if (!parseTrigger(getCmdOption(argc, argv, "+save_checkpoint="), elf, firmware_elf, ckpt_trig)) {
+        exit(EXIT_FAILURE);
+    }
+    ckpt_file = getCmdOption(argc, argv, "+checkpoint_file=");
+    if (ckpt_file.empty()) ckpt_file = CHECKPOINT_FILENAME;
+    ckpt_stop = getCmdOption(argc, argv, "+checkpoint_stop=") == "1";
+
+    // Waveform dump triggers
+    if (!parseTrigger(getCmdOption(argc, argv, "+trace_start="), elf, firmware_elf, trace_start) ||
+        !parseTrigger(getCmdOption(argc, argv, "+trace_stop="), elf, firmware_elf, trace_stop)) {
+        exit(EXIT_FAILURE);
+    }
+    trace_gpio_str = getCmdOption(argc, argv, "+trace_gpio=");
+    trace_ring_str = getCmdOption(argc, argv, "+trace_ring=");
+
+    // Simulation results file
+    stats_file = getCmdOption(argc, argv, "+stats_file=");
+
+    // Firmware profiler
+    profile_prefix = getCmdOption(argc, argv, "+profile=");
+    profile_interval_str = getCmdOption(argc, argv, "+profile_interval=");
+    if (!profile_prefix.empty()) {
+        if (!elf.isOpen() && !elf.open(firmware_elf)) {
+            TB_ERR("Cannot profile the firmware without its ELF file");
+            exit(EXIT_FAILURE);
+        }
+        profiler = new TbProfiler;
+        if (!profiler->open(elf, profile_interval_str.empty() ? 1 : std::stoul(profile_interval_str))) {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Deferred-format firmware log
+    dlog_file = getCmdOption(argc, argv, "+dlog=");
+    if (!dlog_file.empty() && !elf.isOpen() && !elf.open(firmware_elf)) {
+        TB_ERR("Cannot decode the deferred-format log without the firmware ELF file");
+        exit(EXIT_FAILURE);
+    }
+
     // Testbench initialization
     // ------------------------
     // Create log directory
-    if (gen_waves) Verilated::mkdir("logs");
+    if (gen_waves || ckpt_trig.type != TRIG_NONE) Verilated::mkdir("logs");
 
     // Create Verilator simulation context
     VerilatedContext *cntx = new VerilatedContext;
     cntx->commandArgs(argc, argv);
+    if (flash_image.empty() && boot_mode == BOOT_MODE_FLASH) {
+        // Read by the initial block of the boot flash model
+        flash_image = firmware_file;
+        std::string flash_arg = "+SPIFLASH_IMAGE_flash_boot=" + flash_image;
+        const char *flash_argv[] = {flash_arg.c_str()};
+        cntx->commandArgsAdd(1, flash_argv);
+    }
     if (gen_waves) cntx->traceEverOn(true);
 
     // Pass the simulation context to the logger
@@ -175,11 +316,13 @@ int main(int argc, char *argv[])
     Vtb_system *dut = new Vtb_system(cntx);
 
     // Set the file to store the waveforms in
-    VerilatedFstC *trace = NULL;
     if (gen_waves) {
-        trace = new VerilatedFstC;
-        dut->trace(trace, 10);
-        trace->open(FST_FILENAME);
+        trace = new TbTracer;
+        trace->setWindow(trace_start, trace_stop);
+        if (!trace_gpio_str.empty()) trace->setGpio(std::stoi(trace_gpio_str));
+        if (!trace_ring_str.empty()) trace->setRing(std::stoull(trace_ring_str));
+        trace->open(dut, FST_FILENAME, 10);
+        atexit(closeTrace);
     }
 
     // Set scope for DPI functions
@@ -189,25 +332,66 @@ int main(int argc, char *argv[])
         TB_ERR("svSetScope(): failed to set scope for DPI functions to %s", TB_HIER_NAME);
         exit(EXIT_FAILURE);
     }
+
+    // Bind the firmware loader to the SRAM banks
+    if (fast_load && !loader.bind()) {
+        TB_WARN("Fast firmware loader unavailable. Falling back to tb_loadHEX()");
+        fast_load = false;
+    }
+
+    // Open the deferred-format log (read through the SRAM arrays)
+    if (!dlog_file.empty()) {
+        dlog = new TbDlog;
+        if ((!loader.isBound() && !loader.bind()) || !dlog->open(elf, loader, dlog_file)) {
+            exit(EXIT_FAILURE);
+        }
+    }
     
     // Print testbench configuration
     // -----------------------------
     TB_CONFIG("Log level set to %u", logger.getLogLvl());
     TB_CONFIG("Waveform tracing %s", gen_waves ? "enabled" : "disabled");
+    if (gen_waves) trace->printConfig();
     TB_CONFIG("Max simulation cycles set to %lu", max_cycles);
     TB_CONFIG("Boot mode: %s", boot_mode_str.c_str());
     TB_CONFIG("Firmware: %s", firmware_file.c_str());
-    TB_CONFIG("Executing from %s", EXEC_FROM_FLASH ? "flash" : "RAM");
+    TB_CONFIG("Firmware loader: %s", fast_load ? "fast" : "DPI");
+    TB_CONFIG("Executing from %s", exec_from_flash ? "flash" : "RAM");
+    if (ckpt_trig.type != TRIG_NONE) {
+        TB_CONFIG("Saving checkpoint to '%s' at %s", ckpt_file.c_str(), triggerStr(ckpt_trig).c_str());
+    }
+    if (!restore_ckpt_file.empty()) {
+        TB_CONFIG("Restoring checkpoint from '%s'", restore_ckpt_file.c_str());
+    }
+    if (profiler != NULL) profiler->printConfig();
+    if (dlog != NULL) dlog->printConfig();
 
     // RUN SIMULATION
     // --------------
     TB_LOG(LOG_MEDIUM, "Starting simulation");
+    std::chrono::steady_clock::time_point wall_start = std::chrono::steady_clock::now();
+    vluint64_t start_cycles = sim_cycles;
     
     // Initialize the DUT
-    initDut(dut, boot_mode, EXEC_FROM_FLASH);
+    initDut(dut, boot_mode, exec_from_flash);
+
+    // Restore the checkpoint, or reset the DUT and load the firmware
+    if (!restore_ckpt_file.empty()) {
+        std::string ckpt_firmware;
+        if (!restoreCheckpoint(restore_ckpt_file, dut, ckpt_firmware)) {
+            exit(EXIT_FAILURE);
+        }
+        if (!firmware_file.empty() && firmware_file != ckpt_firmware) {
+            TB_WARN("Checkpoint was saved running '%s'", ckpt_firmware.c_str());
+        }
+        boot_mode = BOOT_MODE_CHECKPOINT;
 
-    // Reset the DUT
-    rstDut(dut, gen_waves, trace);
+        // The throughput only covers the cycles simulated by this run
+        wall_start = std::chrono::steady_clock::now();
+        start_cycles = sim_cycles;
+    } else {
+        rstDut(dut, gen_waves, trace);
+    }
 
     // Load firmware to SRAM
     switch (boot_mode)
@@ -219,7 +403,17 @@ int main(int argc, char *argv[])
     case BOOT_MODE_FORCE:
         TB_LOG(LOG_LOW, "Loading firmware...");
         TB_LOG(LOG_MEDIUM, "- writing firmware to SRAM...");
-        dut->tb_loadHEX(firmware_file.c_str());
+        if (fast_load) {
+            if (!loader.load(firmware_file)) {
+                TB_ERR("Failed to load firmware '%s'", firmware_file.c_str());
+                exit(EXIT_FAILURE);
+            }
+        } else if (isElfFile(firmware_file)) {
+            TB_ERR("ELF firmware files require the fast firmware loader");
+            exit(EXIT_FAILURE);
+        } else {
+            dut->tb_loadHEX(firmware_file.c_str());
+        }
         runCycles(1, dut, gen_waves, trace);
         TB_LOG(LOG_MEDIUM, "- triggering boot loop exit...");
         dut->tb_set_exit_loop();
@@ -228,7 +422,11 @@ int main(int argc, char *argv[])
         break;
 
     case BOOT_MODE_FLASH:
-        TB_LOG(LOG_LOW, "Waiting for boot code to load firmware from flash...");
+        TB_LOG(LOG_LOW, "Waiting for boot code to %s firmware from flash...", exec_from_flash ? "run" : "load");
+        break;
+
+    case BOOT_MODE_CHECKPOINT:
+        TB_LOG(LOG_LOW, "Resuming from checkpoint...");
         break;
     
     default:
@@ -236,20 +434,54 @@ int main(int argc, char *argv[])
         exit(EXIT_FAILURE);
     }
 
+    // Profile the firmware from now on
+    if (profiler != NULL) profiler->start();
+
     // Run until the end of simulation is reached
     while (!cntx->gotFinish() && cntx->time() < (max_cycles << 1) && dut->exit_valid_o == 0) {
-        TB_LOG(LOG_FULL, "Running %lu cycles...", RUN_CYCLES);
-        runCycles(RUN_CYCLES, dut, gen_waves, trace);
+        unsigned int ncycles = RUN_CYCLES;
+
+        // Save checkpoint when the trigger is hit
+        if (ckpt_trig.type != TRIG_NONE && !ckpt_saved) {
+            if (triggerHit(ckpt_trig, dut, sim_cycles)) {
+                ckpt_saved = true;
+                if (!saveCheckpoint(ckpt_file, dut, firmware_file)) {
+                    exit(EXIT_FAILURE);
+                }
+                if (ckpt_stop) break;
+                continue;
+            }
+            // Symbol triggers are checked every cycle
+            if (ckpt_trig.type == TRIG_SYMBOL) ncycles = 1;
+            else if (ckpt_trig.cycle - sim_cycles < ncycles) ncycles = ckpt_trig.cycle - sim_cycles;
+        }
+
+        TB_LOG(LOG_FULL, "Running %u cycles...", ncycles);
+        runCycles(ncycles, dut, gen_waves, trace);
+        if (dlog != NULL) dlog->drain();
     }
     if (cntx->time() >= (max_cycles << 1)) {
         TB_WARN("Max simulation cycles reached");
+        max_cycles_reached = true;
+    }
+    if (profiler != NULL) profiler->stop();
+    if (dlog != NULL) {
+        dlog->close();
+        delete dlog;
+        dlog = NULL;
     }
 
     // Print simulation status
     TB_LOG(LOG_LOW, "Simulation complete");
+    double wall_time = printThroughput(sim_cycles - start_cycles, wall_start);
+    if (!stats_file.empty()) {
+        writeStats(stats_file, dut, max_cycles_reached, sim_cycles, wall_time);
+    }
 
     // Check exit value
-    if (dut->exit_valid_o) {
+    if (ckpt_stop && ckpt_saved && !dut->exit_valid_o) {
+        TB_LOG(LOG_LOW, "Simulation stopped after saving checkpoint");
+    } else if (dut->exit_valid_o) {
         TB_LOG(LOG_LOW, "Exit value: %d", dut->exit_value_o);
         exit_val = dut->exit_value_o;
         runCycles(10, dut, gen_waves, trace);
@@ -257,6 +489,17 @@ int main(int argc, char *argv[])
         TB_ERR("No exit value detected");
         exit_val = EXIT_FAILURE;
     }
+    if (ckpt_trig.type != TRIG_NONE && !ckpt_saved) {
+        TB_WARN("Checkpoint trigger %s never reached", triggerStr(ckpt_trig).c_str());
+    }
+
+    // Write the firmware profile
+    if (profiler != NULL) {
+        profiler->printSummary(10);
+        profiler->write(profile_prefix);
+        delete profiler;
+        profiler = NULL;
+    }
 
     // CLEAN UP
     // --------
@@ -264,7 +507,7 @@ int main(int argc, char *argv[])
     dut->final();
 
     // Clean up and exit
-    if (gen_waves) trace->close();
+    closeTrace();
     delete dut;
     delete cntx;
     if (no_err) exit(EXIT_SUCCESS);
@@ -286,7 +529,7 @@ void clkGen(Vtb_system *dut) {
     dut->clk_i ^= 1;
 }
 
-void rstDut(Vtb_system *dut, uint8_t gen_waves, VerilatedFstC *trace) {
+void rstDut(Vtb_system *dut, uint8_t gen_waves, TbTracer *trace) {
     dut->rst_ni = 1;
     TB_LOG(LOG_MEDIUM, "Resetting DUT...");
     runCycles(PRE_RESET_CYCLES, dut, gen_waves, trace);
@@ -298,7 +541,7 @@ void rstDut(Vtb_system *dut, uint8_t gen_waves, VerilatedFstC *trace) {
     runCycles(POST_RESET_CYCLES, dut, gen_waves, trace);
 }
 
-void runCycles(unsigned int ncycles, Vtb_system *dut, uint8_t gen_waves, VerilatedFstC *trace) {
+void runCycles(unsigned int ncycles, Vtb_system *dut, uint8_t gen_waves, TbTracer *trace) {
     VerilatedContext *cntx = dut->contextp();
     for (unsigned int i = 0; i < (2*ncycles); i++) {
         // Generate clock
@@ -308,12 +551,65 @@ void runCycles(unsigned int ncycles, Vtb_system *dut, uint8_t gen_waves, Verilat
         dut->eval();
 
         // Save waveforms
-        if (gen_waves) trace->dump(cntx->time());
-        if (dut->clk_i == 1) sim_cycles++;
+        if (gen_waves) trace->dump(cntx->time(), sim_cycles);
+        if (dut->clk_i == 1) {
+            if (profiler != NULL) profiler->sample(dut);
+            sim_instret += (dut->prof_events_o >> PROF_EV_INSTRET) & 0x1;
+            sim_cycles++;
+        }
         cntx->timeInc(1);
     }
 }
 
+void closeTrace() {
+    if (trace == NULL) return;
+    delete trace;
+    trace = NULL;
+}
+
+double printThroughput(vluint64_t ncycles, std::chrono::steady_clock::time_point wall_start) {
+    std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - wall_start;
+    double secs = wall_time.count();
+    TB_LOG(LOG_LOW, "Simulated %lu cycles in %.3f s (%.0f cycles/s)", ncycles, secs,
+           secs > 0 ? ncycles / secs : 0.0);
+    return secs;
+}
+
+bool writeStats(const std::string &file, Vtb_system *dut, bool max_cycles_reached, vluint64_t ncycles, double wall_time) {
+    FILE *fp = fopen(file.c_str(), "w");
+    if (fp == NULL) {
+        TB_ERR("Cannot open stats file '%s': %s", file.c_str(), strerror(errno));
+        return false;
+    }
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"exit_valid\": %s,\n", dut->exit_valid_o ? "true" : "false");
+    fprintf(fp, "  \"exit_value\": %d,\n", (int)dut->exit_value_o);
+    fprintf(fp, "  \"max_cycles_reached\": %s,\n", max_cycles_reached ? "true" : "false");
+    fprintf(fp, "  \"cycles\": %lu,\n", ncycles);
+    fprintf(fp, "  \"instructions\": %lu,\n", sim_instret);
+    fprintf(fp, "  \"flash\": {");
+    const std::vector<TbFlash *> &flash = tbFlashModels();
+    for (size_t i = 0; i < flash.size(); i++) {
+        fprintf(fp, "%s\n    \"%s\": ", i ? "," : "", flash[i]->getName().c_str());
+        flash[i]->writeStats(fp, "    ");
+    }
+    fprintf(fp, "%s},\n", flash.empty() ? "" : "\n  ");
+    fprintf(fp, "  \"ext_slaves\": {");
+    bool first = true;
+    for (TbExtSlave *slave : tbExtSlaveModels()) {
+        if (slave == NULL) continue;
+        fprintf(fp, "%s\n    \"%s\": ", first ? "" : ",", slave->getName().c_str());
+        slave->writeStats(fp, "    ");
+        first = false;
+    }
+    fprintf(fp, "%s},\n", first ? "" : "\n  ");
+    fprintf(fp, "  \"wall_time\": %.3f\n", wall_time);
+    fprintf(fp, "}\n");
+    fclose(fp);
+    TB_LOG(LOG_MEDIUM, "Simulation results written to '%s'", file.c_str());
+    return true;
+}
+
 std::string getCmdOption(int argc, char* argv[], const std::string& option)
 {
 
@@ -0,0 +1,149 @@
+#include "tb_checkpoint.hh"
+#include "tb_ext_slave.hh"
+#include "tb_flash.hh"
+#include "tb_macros.hh"
+
+#ifdef TB_CHECKPOINT_EN
+#include <verilated_save.h>
+
+// Checkpoint format identifier (bump when the harness state changes)
+#define CHECKPOINT_MAGIC "gr-heep-checkpoint-v4"
+
+// Simulated cycles and retired instructions (defined by the testbench)
+extern vluint64_t sim_cycles;
+extern vluint64_t sim_instret;
+
+bool saveCheckpoint(const std::string &file, Vtb_system *dut, const std::string &firmware)
+{
+    VerilatedContext *cntx = dut->contextp();
+    std::string magic = CHECKPOINT_MAGIC;
+    std::string fw = firmware; // the stream operators take non-const references
+    vluint64_t sim_time = cntx->time();
+    uint32_t n_flash = tbFlashModels().size();
+    uint32_t n_ext = tbExtSlaveModels().size();
+
+    VerilatedSave os;
+    os.open(file.c_str());
+    if (!os.isOpen()) {
+        TB_ERR("Cannot open checkpoint file '%s' for writing", file.c_str());
+        return false;
+    }
+
+    // Testbench state
+    os << magic;
+    os << fw;
+    os << sim_cycles;
+    os << sim_instret;
+    os << sim_time;
+
+    // SPI flash models
+    os << n_flash;
+    for (TbFlash *flash : tbFlashModels()) flash->save(os);
+
+    // External slave models
+    os << n_ext;
+    for (TbExtSlave *slave : tbExtSlaveModels()) slave->save(os);
+
+    // Model state
+    os << *dut;
+    os.close();
+
+    TB_LOG(LOG_LOW, "Checkpoint saved to '%s' (cycle %lu)", file.c_str(), sim_cycles);
+    return true;
+}
+
+bool restoreCheckpoint(const std::string &file, Vtb_system *dut, std::string &firmware)
+{
+    VerilatedContext *cntx = dut->contextp();
+    std::string magic;
+    vluint64_t sim_time = 0;
+    uint32_t n_flash = 0;
+    uint32_t n_ext = 0;
+    void *uart_ctx = NULL;
+    void *flash_ctx[2] = {NULL, NULL};
+
+    VerilatedRestore os;
+    os.open(file.c_str());
+    if (!os.isOpen()) {
+        TB_ERR("Cannot open checkpoint file '%s' for reading", file.c_str());
+        return false;
+    }
+
+    // Testbench state
+    os >> magic;
+    if (magic != CHECKPOINT_MAGIC) {
+        TB_ERR("'%s' is not a valid checkpoint file", file.c_str());
+        os.close();
+        return false;
+    }
+    os >> firmware;
+    os >> sim_cycles;
+    os >> sim_instret;
+    os >> sim_time;
+
+    // SPI flash models: the ones created by this process (with the same
+    // images) get the saved state and the programmed or erased sectors
+    os >> n_flash;
+    if (n_flash != tbFlashModels().size()) {
+        TB_ERR("'%s' was saved with %u SPI flash models (%zu expected)", file.c_str(), n_flash,
+               tbFlashModels().size());
+        os.close();
+        return false;
+    }
+    for (TbFlash *flash : tbFlashModels()) {
+        if (!flash->restore(os)) {
+            os.close();
+            return false;
+        }
+    }
+
+    // External slave models: the RTL refers to them by index, so the ones
+    // created by this process (in the same order) get the saved state
+    os >> n_ext;
+    if (n_ext != tbExtSlaveModels().size()) {
+        TB_ERR("'%s' was saved with %u external slave models (%zu expected)", file.c_str(), n_ext,
+               tbExtSlaveModels().size());
+        os.close();
+        return false;
+    }
+    for (TbExtSlave *slave : tbExtSlaveModels()) {
+        if (!slave->restore(os)) {
+            os.close();
+            return false;
+        }
+    }
+
+    // The UART DPI context (pseudo-terminal and log file) belongs to this
+    // process: keep the one created by the initial blocks of the restored model
+    // instead of the stale pointer stored in the checkpoint.
+    // The same holds for the SPI flash models, restored above.
+    dut->tb_uart_get_ctx(&uart_ctx);
+    for (int i = 0; i < 2; i++) dut->tb_flash_get_ctx(i, &flash_ctx[i]);
+
+    // Model state
+    os >> *dut;
+    os.close();
+
+    dut->tb_uart_set_ctx(uart_ctx);
+    for (int i = 0; i < 2; i++) dut->tb_flash_set_ctx(i, flash_ctx[i]);
+    cntx->time(sim_time);
+
+    TB_LOG(LOG_LOW, "Checkpoint restored from '%s' (cycle %lu)", file.c_str(), sim_cycles);
+    return true;
+}
+
+#else // TB_CHECKPOINT_EN
+
+// The model was built without --savable (e.g., multi-threaded model)
+bool saveCheckpoint(const std::string &file, Vtb_system *dut, const std::string &firmware)
+{
+    TB_ERR("Cannot save '%s': checkpoints are not supported by this model (build the 'sim' target)", file.c_str());
+    return false;
+}
+
+bool restoreCheckpoint(const std::string &file, Vtb_system *dut, std::string &firmware)
+{
+    TB_ERR("Cannot restore '%s': checkpoints are not supported by this model (build the 'sim' target)", file.c_str());
+    return false;
+}
+#endif // TB_CHECKPOINT_EN
@@ -0,0 +1,27 @@
+// Copyright 2026 EPFL and Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_checkpoint.hh
+// Author: agent
+// Date: 16/10/2026
+// Description: Simulation checkpoint save/restore for the Verilator testbench
+
+#if !defined(TB_CHECKPOINT_HH_)
+#define TB_CHECKPOINT_HH_
+
+#include <string>
+#include <verilated.h>
+
+#include "Vtb_system.h"
+
+#define CHECKPOINT_FILENAME "logs/checkpoint.sav"
+
+// Save the complete model state, plus the testbench state, to a file
+bool saveCheckpoint(const std::string &file, Vtb_system *dut, const std::string &firmware);
+
+// Restore the model and testbench state from a file. The model must have been
+// evaluated at least once (i.e., initial blocks executed) before calling this.
+bool restoreCheckpoint(const std::string &file, Vtb_system *dut, std::string &firmware);
+
+#endif // TB_CHECKPOINT_HH_
@@ -0,0 +1,192 @@
+#include <cerrno>
+#include <cstring>
+
+#include "tb_dlog.hh"
+#include "tb_macros.hh"
+
+// Longest string printed by %s
+#define DLOG_MAX_STRING 256
+
+TbDlog::TbDlog()
+{
+    this->loader = NULL;
+    memset(&this->fmt, 0, sizeof(this->fmt));
+    this->ring = 0;
+    this->out = NULL;
+    this->records = 0;
+    this->words = 0;
+}
+
+TbDlog::~TbDlog()
+{
+    if (this->out != NULL && this->out != stdout) fclose(this->out);
+}
+
+bool TbDlog::open(TbElf &elf, TbLoader &loader, const std::string &file)
+{
+    if (!elf.getSymbol(TB_DLOG_RING_SYMBOL, this->ring)) {
+        TB_ERR("No '%s' in '%s': build the firmware with CDEFS=DLOG_DEFERRED", TB_DLOG_RING_SYMBOL,
+               elf.getPath().c_str());
+        return false;
+    }
+    if (!elf.getSection(TB_DLOG_FMT_SECTION, this->fmt)) {
+        TB_ERR("No %s section in '%s'", TB_DLOG_FMT_SECTION, elf.getPath().c_str());
+        return false;
+    }
+    if (!loader.isBound()) {
+        TB_ERR("The deferred-format log requires access to the SRAM arrays");
+        return false;
+    }
+
+    this->out = file == "-" ? stdout : fopen(file.c_str(), "w");
+    if (this->out == NULL) {
+        TB_ERR("Cannot open log file '%s': %s", file.c_str(), strerror(errno));
+        return false;
+    }
+    this->loader = &loader;
+    this->out_file = file;
+    return true;
+}
+
+uint32_t TbDlog::readRing(uint32_t offset)
+{
+    uint32_t data = 0;
+    this->loader->readWord(this->ring + offset, data);
+    return data;
+}
+
+std::string TbDlog::readString(uint32_t addr)
+{
+    std::string str;
+    uint32_t word = 0;
+
+    for (uint32_t a = addr; str.size() < DLOG_MAX_STRING; a++) {
+        if (a == addr || (a & 0x3) == 0) {
+            if (!this->loader->readWord(a & ~0x3U, word)) return "(bad address)";
+        }
+        char c = (char)(word >> (8 * (a & 0x3)));
+        if (c == '\0') break;
+        str.push_back(c);
+    }
+    return str;
+}
+
+std::string TbDlog::format(const char *fmt, const uint32_t *args, uint32_t nargs)
+{
+    std::string str;
+    char buf[DLOG_MAX_STRING + 64];
+    uint32_t arg = 0;
+
+    for (const char *p = fmt; *p != '\0'; p++) {
+        if (*p != '%') {
+            str.push_back(*p);
+            continue;
+        }
+        if (p[1] == '%') {
+            str.push_back('%');
+            p++;
+            continue;
+        }
+
+        // Flags, width and precision are passed on; length modifiers are
+        // dropped, since every argument is a 32-bit word
+        std::string spec = "%";
+        for (p++; *p != '\0' && strchr("-+ #0123456789.*hlzjtL", *p) != NULL; p++) {
+            if (*p == '*') {
+                spec += std::to_string(arg < nargs ? (int32_t)args[arg++] : 0);
+            } else if (strchr("hlzjtL", *p) == NULL) {
+                spec.push_back(*p);
+            }
+        }
+        if (*p == '\0') break;
+
+        uint32_t val = arg < nargs ? args[arg++] : 0;
+        switch (*p) {
+        case 'd':
+        case 'i':
+            spec.push_back('d');
+            snprintf(buf, sizeof(buf), spec.c_str(), (int32_t)val);
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+        case 'c':
+            spec.push_back(*p);
+            snprintf(buf, sizeof(buf), spec.c_str(), val);
+            break;
+        case 'p':
+            snprintf(buf, sizeof(buf), "0x%08x", val);
+            break;
+        case 's':
+            spec.push_back('s');
+            snprintf(buf, sizeof(buf), spec.c_str(), this->readString(val).c_str());
+            break;
+        default:
+            // e.g., floating-point conversions
+            snprintf(buf, sizeof(buf), "<%%%c?>", *p);
+            break;
+        }
+        str += buf;
+    }
+    return str;
+}
+
+void TbDlog::drain()
+{
+    uint32_t size, head, tail;
+    uint32_t args[TB_DLOG_MAX_ARGS];
+
+    // Nothing to do until the firmware is loaded
+    if (this->loader == NULL || this->readRing(TB_DLOG_MAGIC_OFFSET) != TB_DLOG_MAGIC) return;
+    size = this->readRing(TB_DLOG_SIZE_OFFSET);
+    head = this->readRing(TB_DLOG_HEAD_OFFSET);
+    tail = this->readRing(TB_DLOG_TAIL_OFFSET);
+    if (size == 0 || (size & (size - 1)) != 0 || head - tail > size) return;
+
+    while (tail != head) {
+        uint32_t hdr = this->readRing(TB_DLOG_BUF_OFFSET + 4 * (tail & (size - 1)));
+        uint32_t nargs = hdr >> TB_DLOG_NARGS_SHIFT;
+        uint32_t off = (hdr & TB_DLOG_FMT_MASK) - this->fmt.addr;
+
+        if (nargs > TB_DLOG_MAX_ARGS || nargs >= head - tail || off >= this->fmt.size ||
+            memchr(this->fmt.data + off, '\0', this->fmt.size - off) == NULL) {
+            TB_WARN("Corrupted deferred-format log record 0x%08x: %u words skipped", hdr, head - tail);
+            tail = head;
+            break;
+        }
+        for (uint32_t i = 0; i < nargs; i++) {
+            args[i] = this->readRing(TB_DLOG_BUF_OFFSET + 4 * ((tail + 1 + i) & (size - 1)));
+        }
+        fputs(this->format((const char *)this->fmt.data + off, args, nargs).c_str(), this->out);
+
+        tail += 1 + nargs;
+        this->records++;
+        this->words += 1 + nargs;
+    }
+
+    // Free the room of the decoded records
+    this->loader->writeWord(this->ring + TB_DLOG_TAIL_OFFSET, tail);
+}
+
+void TbDlog::close()
+{
+    if (this->loader == NULL) return;
+    this->drain();
+    fflush(this->out);
+
+    uint32_t dropped = this->readRing(TB_DLOG_DROPPED_OFFSET);
+    TB_LOG(LOG_LOW, "Deferred-format log: %lu records (%lu words) decoded into '%s', %u dropped",
+           this->records, this->words, this->out_file.c_str(), dropped);
+    if (dropped != 0) {
+        TB_WARN("%u firmware log records dropped: increase DLOG_RING_WORDS", dropped);
+    }
+    if (this->out != stdout) fclose(this->out);
+    this->out = NULL;
+    this->loader = NULL;
+}
+
+void TbDlog::printConfig()
+{
+    TB_CONFIG("Decoding the deferred-format log at 0x%08x into '%s'", this->ring, this->out_file.c_str());
+}
@@ -0,0 +1,75 @@
+// Copyright 2026 EPFL and Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_dlog.hh
+// Author: agent
+// Date: 16/10/2026
+// Description: Decoder of the deferred-format firmware log (dlog_sdk.h)
+
+#if !defined(TB_DLOG_HH_)
+#define TB_DLOG_HH_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <verilated.h>
+
+#include "tb_elf.hh"
+#include "tb_loader.hh"
+
+// Firmware ring buffer (dlog_ring_t in dlog_sdk.h)
+#define TB_DLOG_RING_SYMBOL "dlog_ring"
+#define TB_DLOG_HEAD_OFFSET 0x0
+#define TB_DLOG_TAIL_OFFSET 0x4
+#define TB_DLOG_DROPPED_OFFSET 0x8
+#define TB_DLOG_SIZE_OFFSET 0xc
+#define TB_DLOG_MAGIC_OFFSET 0x10
+#define TB_DLOG_BUF_OFFSET 0x14
+#define TB_DLOG_MAGIC 0x474f4c44
+#define TB_DLOG_MAX_ARGS 8
+#define TB_DLOG_NARGS_SHIFT 24
+#define TB_DLOG_FMT_MASK 0xffffff
+
+// Section holding the format strings
+#define TB_DLOG_FMT_SECTION ".dlog_fmt"
+
+// Class definition
+class TbDlog
+{
+private:
+    TbLoader *loader;
+    tb_elf_segment_t fmt;    // format strings
+    uint32_t ring;           // address of the ring buffer
+    FILE *out;
+    std::string out_file;
+    vluint64_t records;
+    vluint64_t words;
+
+    // Read a word of the ring buffer
+    uint32_t readRing(uint32_t offset);
+
+    // Read a NUL-terminated string from the SRAM
+    std::string readString(uint32_t addr);
+
+    // Format a record
+    std::string format(const char *fmt, const uint32_t *args, uint32_t nargs);
+public:
+    TbDlog();
+    ~TbDlog();
+
+    // Find the ring buffer and the format strings in the firmware ELF file.
+    // The log is written to file ("-": standard output).
+    bool open(TbElf &elf, TbLoader &loader, const std::string &file);
+
+    // Decode the records written by the firmware so far and free their room
+    // in the ring buffer
+    void drain();
+
+    // Decode the last records and report the statistics
+    void close();
+
+    void printConfig();
+};
+
+#endif // TB_DLOG_HH_
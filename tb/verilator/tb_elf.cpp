@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <gelf.h>
+
+#include "tb_elf.hh"
+#include "tb_macros.hh"
+
+TbElf::TbElf()
+{
+    this->fd = -1;
+    this->elf = NULL;
+}
+
+TbElf::~TbElf()
+{
+    this->close();
+}
+
+bool TbElf::open(const std::string &path)
+{
+    this->close();
+
+    if (elf_version(EV_CURRENT) == EV_NONE) {
+        TB_ERR("libelf initialization failed: %s", elf_errmsg(-1));
+        return false;
+    }
+
+    this->fd = ::open(path.c_str(), O_RDONLY);
+    if (this->fd < 0) {
+        TB_ERR("Cannot open ELF file '%s': %s", path.c_str(), strerror(errno));
+        return false;
+    }
+
+    this->elf = elf_begin(this->fd, ELF_C_READ_MMAP, NULL);
+    if (this->elf == NULL || elf_kind(this->elf) != ELF_K_ELF) {
+        TB_ERR("'%s' is not a valid ELF file", path.c_str());
+        this->close();
+        return false;
+    }
+
+    this->path = path;
+    this->readSymbols();
+    TB_LOG(LOG_HIGH, "Read %lu symbols from '%s'", this->symbols.size(), path.c_str());
+
+    return true;
+}
+
+void TbElf::close()
+{
+    if (this->elf != NULL) elf_end(this->elf);
+    if (this->fd >= 0) ::close(this->fd);
+    this->elf = NULL;
+    this->fd = -1;
+    this->symbols.clear();
+    this->functions.clear();
+}
+
+bool TbElf::isOpen()
+{
+    return this->elf != NULL;
+}
+
+const std::string &TbElf::getPath()
+{
+    return this->path;
+}
+
+void TbElf::readSymbols()
+{
+    Elf_Scn *scn = NULL;
+    GElf_Shdr shdr;
+
+    while ((scn = elf_nextscn(this->elf, scn)) != NULL) {
+        if (gelf_getshdr(scn, &shdr) == NULL || shdr.sh_type != SHT_SYMTAB) continue;
+
+        Elf_Data *data = elf_getdata(scn, NULL);
+        if (data == NULL || shdr.sh_entsize == 0) continue;
+
+        size_t nsyms = shdr.sh_size / shdr.sh_entsize;
+        for (size_t i = 0; i < nsyms; i++) {
+            GElf_Sym sym;
+            if (gelf_getsym(data, i, &sym) == NULL) continue;
+
+            // Only keep named functions and data objects
+            int type = GELF_ST_TYPE(sym.st_info);
+            if (type != STT_FUNC && type != STT_OBJECT && type != STT_NOTYPE) continue;
+            const char *name = elf_strptr(this->elf, shdr.sh_link, sym.st_name);
+            if (name == NULL || name[0] == '\0') continue;
+
+            // Functions (including the local ones) are kept for symbolization
+            if (type == STT_FUNC) {
+                tb_elf_func_t func = {name, (uint32_t)sym.st_value, (uint32_t)sym.st_size};
+                this->functions.push_back(func);
+            }
+
+            // Global symbols take precedence over local ones with the same name
+            if (this->symbols.count(name) && GELF_ST_BIND(sym.st_info) == STB_LOCAL) continue;
+            this->symbols[name] = (uint32_t)sym.st_value;
+        }
+    }
+
+    // Sort functions by address and drop aliases
+    std::stable_sort(this->functions.begin(), this->functions.end(),
+                     [](const tb_elf_func_t &a, const tb_elf_func_t &b) { return a.addr < b.addr; });
+    this->functions.erase(std::unique(this->functions.begin(), this->functions.end(),
+                                      [](const tb_elf_func_t &a, const tb_elf_func_t &b) { return a.addr == b.addr; }),
+                          this->functions.end());
+
+    // Functions without size (e.g., assembly routines) extend to the next one
+    for (size_t i = 0; i < this->functions.size(); i++) {
+        if (this->functions[i].size != 0) continue;
+        if (i + 1 < this->functions.size()) {
+            this->functions[i].size = this->functions[i + 1].addr - this->functions[i].addr;
+        } else {
+            this->functions[i].size = 4;
+        }
+    }
+}
+
+bool TbElf::getSymbol(const std::string &name, uint32_t &addr)
+{
+    std::map<std::string, uint32_t>::iterator it = this->symbols.find(name);
+    if (it == this->symbols.end()) return false;
+    addr = it->second;
+    return true;
+}
+
+const std::vector<tb_elf_func_t> &TbElf::getFunctions()
+{
+    return this->functions;
+}
+
+std::vector<tb_elf_segment_t> TbElf::getLoadSegments()
+{
+    std::vector<tb_elf_segment_t> segments;
+    size_t nphdrs = 0;
+    size_t file_size = 0;
+
+    if (this->elf == NULL) return segments;
+    const uint8_t *raw = (const uint8_t *)elf_rawfile(this->elf, &file_size);
+    if (raw == NULL || elf_getphdrnum(this->elf, &nphdrs) != 0) return segments;
+
+    for (size_t i = 0; i < nphdrs; i++) {
+        GElf_Phdr phdr;
+        if (gelf_getphdr(this->elf, i, &phdr) == NULL) continue;
+        if (phdr.p_type != PT_LOAD || phdr.p_filesz == 0) continue;
+        if (phdr.p_offset + phdr.p_filesz > file_size) {
+            TB_WARN("Segment %lu of '%s' exceeds the file size", i, this->path.c_str());
+            continue;
+        }
+
+        tb_elf_segment_t seg;
+        seg.addr = (uint32_t)phdr.p_paddr;
+        seg.data = raw + phdr.p_offset;
+        seg.size = phdr.p_filesz;
+        segments.push_back(seg);
+    }
+    return segments;
+}
+
+bool TbElf::getSection(const std::string &name, tb_elf_segment_t &section)
+{
+    Elf_Scn *scn = NULL;
+    GElf_Shdr shdr;
+    size_t shstrndx;
+    size_t file_size = 0;
+
+    if (this->elf == NULL || elf_getshdrstrndx(this->elf, &shstrndx) != 0) return false;
+    const uint8_t *raw = (const uint8_t *)elf_rawfile(this->elf, &file_size);
+    if (raw == NULL) return false;
+
+    while ((scn = elf_nextscn(this->elf, scn)) != NULL) {
+        if (gelf_getshdr(scn, &shdr) == NULL) continue;
+        const char *scn_name = elf_strptr(this->elf, shstrndx, shdr.sh_name);
+        if (scn_name == NULL || name != scn_name) continue;
+        if (shdr.sh_type == SHT_NOBITS || shdr.sh_offset + shdr.sh_size > file_size) return false;
+
+        section.addr = (uint32_t)shdr.sh_addr;
+        section.data = raw + shdr.sh_offset;
+        section.size = shdr.sh_size;
+        return true;
+    }
+    return false;
+}
+
+bool isElfFile(const std::string &path)
+{
+    char magic[SELFMAG];
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (fp == NULL) return false;
+    size_t n = fread(magic, 1, SELFMAG, fp);
+    fclose(fp);
+    return n == SELFMAG && memcmp(magic, ELFMAG, SELFMAG) == 0;
+}
+
+std::string elfFromHex(const std::string &hex_file)
+{
+    size_t dot = hex_file.find_last_of('.');
+    size_t slash = hex_file.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return hex_file + ".elf";
+    }
+    return hex_file.substr(0, dot) + ".elf";
+}
@@ -0,0 +1,77 @@
+// Copyright 2026 EPFL and Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_elf.hh
+// Author: agent
+// Date: 16/10/2026
+// Description: Firmware ELF reader for the Verilator testbench
+
+#if !defined(TB_ELF_HH_)
+#define TB_ELF_HH_
+
+#include <cstdint>
+#include <string>
+#include <map>
+#include <vector>
+
+#include <libelf.h>
+
+// Loadable segment (points into the memory-mapped ELF file)
+typedef struct {
+    uint32_t addr;      // load (physical) address
+    const uint8_t *data; // segment content
+    size_t size;        // number of bytes stored in the file
+} tb_elf_segment_t;
+
+// Firmware function (address range)
+typedef struct {
+    std::string name;
+    uint32_t addr;
+    uint32_t size;
+} tb_elf_func_t;
+
+// Class definition
+class TbElf
+{
+private:
+    int fd;
+    Elf *elf;
+    std::string path;
+    std::map<std::string, uint32_t> symbols; // symbol name -> address
+    std::vector<tb_elf_func_t> functions;    // sorted by address
+
+    // Read the symbol table
+    void readSymbols();
+public:
+    TbElf();
+    ~TbElf();
+
+    // Open the ELF file and read its symbol table
+    bool open(const std::string &path);
+    void close();
+    bool isOpen();
+
+    // Get the ELF file path
+    const std::string &getPath();
+
+    // Look up the address of a symbol
+    bool getSymbol(const std::string &name, uint32_t &addr);
+
+    // Get the firmware functions, sorted by address
+    const std::vector<tb_elf_func_t> &getFunctions();
+
+    // Get the loadable segments
+    std::vector<tb_elf_segment_t> getLoadSegments();
+
+    // Get the content of a section by name (addr is the section address)
+    bool getSection(const std::string &name, tb_elf_segment_t &section);
+};
+
+// Check whether a file is an ELF file
+bool isElfFile(const std::string &path);
+
+// Get the ELF file associated with a firmware HEX file (main.hex -> main.elf)
+std::string elfFromHex(const std::string &hex_file);
+
+#endif // TB_ELF_HH_
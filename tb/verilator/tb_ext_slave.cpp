@@ -0,0 +1,403 @@
+#include <cstdlib>
+#include <cstring>
+
+#include <svdpi.h>
+
+#include "tb_ext_slave.hh"
+#include "tb_macros.hh"
+
+// Device attached before the creation of its slave
+typedef struct {
+    std::string slave;
+    uint32_t base;
+    uint32_t size;
+    TbExtDevice *dev;
+} ext_pending_t;
+
+// Slave models created by the RTL, indexed by the identifier returned to it
+// (NULL once closed)
+static std::vector<TbExtSlave *> ext_slaves;
+
+const std::vector<TbExtSlave *> &tbExtSlaveModels()
+{
+    return ext_slaves;
+}
+
+// Function-local, so that devices can be attached by static initializers of
+// other files
+static std::vector<ext_pending_t> &pendingDevices()
+{
+    static std::vector<ext_pending_t> pending;
+    return pending;
+}
+
+bool tbExtSlaveAttach(const std::string &slave, uint32_t base, uint32_t size, TbExtDevice *dev)
+{
+    for (TbExtSlave *s : ext_slaves) {
+        if (s != NULL && s->getName() == slave) {
+            s->attach(base, size, dev);
+            return true;
+        }
+    }
+    pendingDevices().push_back({slave, base, size, dev});
+    return true;
+}
+
+TbExtSlave::TbExtSlave(const std::string &name)
+{
+    this->name = name;
+    this->gnt_latency = 0;
+    this->rvalid_latency = 1;
+    this->depth = 1;
+    this->cycle = 0;
+    memset(&this->stats, 0, sizeof(this->stats));
+    this->reset();
+}
+
+TbExtSlave::~TbExtSlave()
+{
+    for (auto &p : this->pages) delete[] p.second;
+    for (range_t &r : this->ranges) delete r.dev;
+}
+
+void TbExtSlave::setLatency(unsigned int gnt_latency, unsigned int rvalid_latency, unsigned int depth)
+{
+    this->gnt_latency = gnt_latency;
+    this->rvalid_latency = rvalid_latency;
+    this->depth = depth;
+}
+
+void TbExtSlave::attach(uint32_t base, uint32_t size, TbExtDevice *dev)
+{
+    this->ranges.push_back({base, size, dev});
+    TB_CONFIG("External slave '%s': device attached at 0x%08x-0x%08x", this->name.c_str(), base,
+              base + size - 1);
+}
+
+void TbExtSlave::reset()
+{
+    this->gnt_q = false;
+    this->wait = 0;
+    this->extra = 0;
+    this->reg_rdata = 0;
+    this->rsp.clear();
+}
+
+uint32_t TbExtSlave::readWord(uint32_t addr)
+{
+    auto it = this->pages.find(addr >> TB_EXT_PAGE_BITS);
+    if (it == this->pages.end()) return 0;
+
+    uint32_t data;
+    memcpy(&data, it->second + (addr & (TB_EXT_PAGE_SIZE - 4)), sizeof(data));
+    return data;
+}
+
+void TbExtSlave::writeWord(uint32_t addr, uint32_t data, uint8_t be)
+{
+    uint8_t *&page = this->pages[addr >> TB_EXT_PAGE_BITS];
+    if (page == NULL) {
+        page = new uint8_t[TB_EXT_PAGE_SIZE];
+        memset(page, 0, TB_EXT_PAGE_SIZE);
+    }
+    uint8_t *word = page + (addr & (TB_EXT_PAGE_SIZE - 4));
+    for (int b = 0; b < 4; b++) {
+        if (be & (1U << b)) word[b] = (uint8_t)(data >> (8 * b));
+    }
+}
+
+unsigned int TbExtSlave::access(bool we, uint8_t be, uint32_t addr, uint32_t wdata, uint32_t &rdata)
+{
+    rdata = 0;
+    if (this->stats.reads + this->stats.writes == 0) this->stats.first_cycle = this->cycle;
+    this->stats.last_cycle = this->cycle;
+    if (we) {
+        this->stats.writes++;
+        this->stats.write_bytes += __builtin_popcount(be & 0xf);
+    } else {
+        this->stats.reads++;
+        this->stats.read_bytes += 4;
+    }
+
+    for (range_t &r : this->ranges) {
+        if (addr - r.base >= r.size) continue;
+        this->stats.device_accesses++;
+        return we ? r.dev->write(addr - r.base, wdata, be) : r.dev->read(addr - r.base, rdata);
+    }
+
+    if (we) this->writeWord(addr, wdata, be);
+    else rdata = this->readWord(addr);
+    return 0;
+}
+
+void TbExtSlave::tick()
+{
+    for (range_t &r : this->ranges) r.dev->tick(this->cycle);
+    this->cycle++;
+}
+
+void TbExtSlave::evalObi(bool rst_n, bool req, bool we, uint8_t be, uint32_t addr, uint32_t wdata, bool &gnt,
+                         bool &rvalid, uint32_t &rdata)
+{
+    bool accepted = false;
+
+    gnt = false;
+    rvalid = false;
+    rdata = 0;
+    if (!rst_n) {
+        this->reset();
+        this->cycle++;
+        return;
+    }
+
+    // Requests granted in this cycle
+    if (req && this->gnt_q) {
+        ext_slave_rsp_t r;
+        unsigned int extra = this->access(we, be, addr, wdata, r.rdata);
+        r.accepted = this->cycle;
+        r.ready = this->cycle + this->rvalid_latency + extra;
+        if (!this->rsp.empty() && r.ready <= this->rsp.back().ready) r.ready = this->rsp.back().ready + 1;
+        this->rsp.push_back(r);
+        if (this->rsp.size() > this->stats.max_outstanding) this->stats.max_outstanding = this->rsp.size();
+        this->wait = 0;
+        accepted = true;
+    } else if (req) {
+        this->wait++;
+        this->stats.gnt_wait++;
+    } else {
+        this->wait = 0;
+    }
+
+    // Response of the next cycle (in order)
+    if (!this->rsp.empty() && this->rsp.front().ready <= this->cycle + 1) {
+        rvalid = true;
+        rdata = this->rsp.front().rdata;
+        this->stats.latency += this->cycle + 1 - this->rsp.front().accepted;
+        this->rsp.pop_front();
+    }
+
+    // Grant of the next cycle: without wait states, the grant is asserted in
+    // advance whenever there is room for a request
+    this->gnt_q = this->rsp.size() < this->depth &&
+                  (this->gnt_latency == 0 || (req && !accepted && this->wait >= this->gnt_latency));
+    gnt = this->gnt_q;
+
+    this->tick();
+}
+
+void TbExtSlave::evalReg(bool rst_n, bool valid, bool write, uint8_t wstrb, uint32_t addr, uint32_t wdata,
+                         bool &ready, uint32_t &rdata)
+{
+    ready = false;
+    rdata = 0;
+    if (!rst_n) {
+        this->reset();
+        this->cycle++;
+        return;
+    }
+
+    if (valid && this->gnt_q) {
+        // Access completed in this cycle
+        this->gnt_q = false;
+        this->wait = 0;
+    } else if (valid) {
+        // The request is held until ready: perform it when it is first seen
+        if (this->wait == 0) this->extra = this->access(write, wstrb, addr, wdata, this->reg_rdata);
+        this->wait++;
+        if (this->wait >= this->gnt_latency + this->rvalid_latency + this->extra) {
+            this->gnt_q = true;
+            this->stats.latency += this->wait;
+            this->stats.max_outstanding = 1;
+        } else {
+            this->stats.gnt_wait++;
+        }
+    } else {
+        this->wait = 0;
+    }
+    ready = this->gnt_q;
+    rdata = write ? 0 : this->reg_rdata;
+
+    this->tick();
+}
+
+const std::string &TbExtSlave::getName()
+{
+    return this->name;
+}
+
+const ext_slave_stats_t &TbExtSlave::getStats()
+{
+    return this->stats;
+}
+
+void TbExtSlave::printStats()
+{
+    vluint64_t accesses = this->stats.reads + this->stats.writes;
+    if (accesses == 0) return;
+
+    vluint64_t span = this->stats.last_cycle - this->stats.first_cycle + 1;
+    TB_LOG(LOG_LOW, "External slave '%s': %lu reads (%lu bytes), %lu writes (%lu bytes), %lu device accesses",
+           this->name.c_str(), this->stats.reads, this->stats.read_bytes, this->stats.writes,
+           this->stats.write_bytes, this->stats.device_accesses);
+    TB_LOG(LOG_LOW, "- %.2f cycles average latency, %lu cycles waiting for grant, %lu outstanding at most",
+           (double)this->stats.latency / accesses, this->stats.gnt_wait, this->stats.max_outstanding);
+    TB_LOG(LOG_LOW, "- %.3f bytes/cycle over %lu cycles, %lu KiB of memory allocated",
+           (double)(this->stats.read_bytes + this->stats.write_bytes) / span, span,
+           (vluint64_t)this->pages.size() * TB_EXT_PAGE_SIZE / 1024);
+}
+
+void TbExtSlave::writeStats(FILE *fp, const char *indent)
+{
+    fprintf(fp, "{\n");
+    fprintf(fp, "%s  \"gnt_latency\": %u,\n", indent, this->gnt_latency);
+    fprintf(fp, "%s  \"rvalid_latency\": %u,\n", indent, this->rvalid_latency);
+    fprintf(fp, "%s  \"depth\": %u,\n", indent, this->depth);
+    fprintf(fp, "%s  \"reads\": %lu,\n", indent, this->stats.reads);
+    fprintf(fp, "%s  \"writes\": %lu,\n", indent, this->stats.writes);
+    fprintf(fp, "%s  \"read_bytes\": %lu,\n", indent, this->stats.read_bytes);
+    fprintf(fp, "%s  \"write_bytes\": %lu,\n", indent, this->stats.write_bytes);
+    fprintf(fp, "%s  \"device_accesses\": %lu,\n", indent, this->stats.device_accesses);
+    fprintf(fp, "%s  \"gnt_wait\": %lu,\n", indent, this->stats.gnt_wait);
+    fprintf(fp, "%s  \"latency\": %lu,\n", indent, this->stats.latency);
+    fprintf(fp, "%s  \"max_outstanding\": %lu,\n", indent, this->stats.max_outstanding);
+    fprintf(fp, "%s  \"first_cycle\": %lu,\n", indent, this->stats.first_cycle);
+    fprintf(fp, "%s  \"last_cycle\": %lu\n", indent, this->stats.last_cycle);
+    fprintf(fp, "%s}", indent);
+}
+
+#ifdef TB_CHECKPOINT_EN
+void TbExtSlave::save(VerilatedSerialize &os)
+{
+    uint32_t n_rsp = this->rsp.size();
+    uint32_t n_pages = this->pages.size();
+    uint32_t n_devs = this->ranges.size();
+
+    os << this->name;
+
+    // Bus state and pending responses
+    os << this->cycle << this->gnt_q << this->wait << this->extra << this->reg_rdata;
+    os << n_rsp;
+    for (ext_slave_rsp_t &r : this->rsp) os << r.accepted << r.ready << r.rdata;
+    os.write(&this->stats, sizeof(this->stats));
+
+    // Sparse memory
+    os << n_pages;
+    for (auto &p : this->pages) {
+        uint32_t page = p.first;
+        os << page;
+        os.write(p.second, TB_EXT_PAGE_SIZE);
+    }
+
+    // Attached devices
+    os << n_devs;
+    for (range_t &r : this->ranges) r.dev->save(os);
+}
+
+bool TbExtSlave::restore(VerilatedDeserialize &is)
+{
+    std::string name;
+    uint32_t n_rsp, n_pages, n_devs, page;
+
+    is >> name;
+    if (name != this->name) {
+        TB_ERR("Checkpoint of external slave '%s' restored into '%s'", name.c_str(), this->name.c_str());
+        return false;
+    }
+
+    // Bus state and pending responses
+    is >> this->cycle >> this->gnt_q >> this->wait >> this->extra >> this->reg_rdata;
+    is >> n_rsp;
+    this->rsp.resize(n_rsp);
+    for (ext_slave_rsp_t &r : this->rsp) is >> r.accepted >> r.ready >> r.rdata;
+    is.read(&this->stats, sizeof(this->stats));
+
+    // Sparse memory (replaces the pages written so far)
+    for (auto &p : this->pages) delete[] p.second;
+    this->pages.clear();
+    is >> n_pages;
+    for (uint32_t i = 0; i < n_pages; i++) {
+        is >> page;
+        uint8_t *&data = this->pages[page];
+        if (data == NULL) data = new uint8_t[TB_EXT_PAGE_SIZE];
+        is.read(data, TB_EXT_PAGE_SIZE);
+    }
+
+    // Attached devices
+    is >> n_devs;
+    if (n_devs != this->ranges.size()) {
+        TB_ERR("External slave '%s': checkpoint saved with %u devices (%zu attached)", name.c_str(), n_devs,
+               this->ranges.size());
+        return false;
+    }
+    for (range_t &r : this->ranges) {
+        if (!r.dev->restore(is)) return false;
+    }
+    return true;
+}
+#endif // TB_CHECKPOINT_EN
+
+// DPI functions (see tb/obislavedpi.sv and tb/regslavedpi.sv)
+// -----------------------------------------------------------
+static TbExtSlave *extSlave(int id)
+{
+    return id >= 0 && (size_t)id < ext_slaves.size() ? ext_slaves[id] : NULL;
+}
+
+extern "C" int extslavedpi_create(const char *name, int gnt_latency, int rvalid_latency, int depth)
+{
+    if (rvalid_latency < 1 || depth < 1 || gnt_latency < 0) {
+        TB_ERR("External slave '%s': invalid latency (grant %d, response %d) or depth (%d)", name, gnt_latency,
+               rvalid_latency, depth);
+        exit(EXIT_FAILURE);
+    }
+
+    TbExtSlave *slave = new TbExtSlave(name);
+    slave->setLatency(gnt_latency, rvalid_latency, depth);
+    ext_slaves.push_back(slave);
+    TB_CONFIG("External slave '%s': %d wait states before grant, %d cycles to response, %d outstanding", name,
+              gnt_latency, rvalid_latency, depth);
+
+    // Devices attached before the slave was created
+    std::vector<ext_pending_t> &pending = pendingDevices();
+    for (auto it = pending.begin(); it != pending.end();) {
+        if (it->slave == name) {
+            slave->attach(it->base, it->size, it->dev);
+            it = pending.erase(it);
+        } else {
+            it++;
+        }
+    }
+    return (int)ext_slaves.size() - 1;
+}
+
+extern "C" void extslavedpi_close(int id)
+{
+    TbExtSlave *slave = extSlave(id);
+    if (slave == NULL) return;
+    slave->printStats();
+    ext_slaves[id] = NULL;
+    delete slave;
+}
+
+extern "C" void obislavedpi_eval(int id, svBit rst_n, svBit req, svBit we, const svBitVecVal *be, int addr,
+                                 int wdata, svBit *gnt, svBit *rvalid, int *rdata)
+{
+    TbExtSlave *slave = extSlave(id);
+    bool g = false, v = false;
+    uint32_t d = 0;
+    if (slave != NULL) slave->evalObi(rst_n, req, we, (uint8_t)*be, addr, wdata, g, v, d);
+    *gnt = g;
+    *rvalid = v;
+    *rdata = (int)d;
+}
+
+extern "C" void regslavedpi_eval(int id, svBit rst_n, svBit valid, svBit write, const svBitVecVal *wstrb,
+                                 int addr, int wdata, svBit *ready, int *rdata)
+{
+    TbExtSlave *slave = extSlave(id);
+    bool r = false;
+    uint32_t d = 0;
+    if (slave != NULL) slave->evalReg(rst_n, valid, write, (uint8_t)*wstrb, addr, wdata, r, d);
+    *ready = r;
+    *rdata = (int)d;
+}
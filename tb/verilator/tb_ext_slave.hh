@@ -0,0 +1,157 @@
+// Copyright 2026 EPFL and Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_ext_slave.hh
+// Author: agent
+// Date: 16/10/2026
+// Description: Models of the external bus slaves (ext_xbar_slaves) and of the
+//              external peripherals (ext_periph), connected to the RTL
+//              through the obislavedpi and regslavedpi modules
+
+#if !defined(TB_EXT_SLAVE_HH_)
+#define TB_EXT_SLAVE_HH_
+
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <verilated.h>
+#ifdef TB_CHECKPOINT_EN
+#include <verilated_save.h>
+#endif
+
+// Sparse memory page size (allocated on the first write)
+#define TB_EXT_PAGE_BITS 12
+#define TB_EXT_PAGE_SIZE (1U << TB_EXT_PAGE_BITS)
+
+// Device model attached to an address range of an external slave, e.g., an
+// accelerator stand-in. The accesses to the range are forwarded to the device
+// instead of the sparse memory of the slave.
+class TbExtDevice
+{
+public:
+    virtual ~TbExtDevice() {}
+
+    // Handle a read or a write at the given offset from the start of the
+    // range (byte enables in be). Return the cycles to add to the latency of
+    // the slave.
+    virtual unsigned int read(uint32_t offset, uint32_t &rdata) = 0;
+    virtual unsigned int write(uint32_t offset, uint32_t wdata, uint8_t be) = 0;
+
+    // Called on every clock cycle, after the accesses of the cycle
+    virtual void tick(vluint64_t /*cycle*/) {}
+
+#ifdef TB_CHECKPOINT_EN
+    // Save and restore the state of the device (the same devices must be
+    // attached, in the same order, in the restoring process)
+    virtual void save(VerilatedSerialize & /*os*/) {}
+    virtual bool restore(VerilatedDeserialize & /*is*/) { return true; }
+#endif
+};
+
+// Accepted OBI request waiting for its response
+typedef struct {
+    vluint64_t accepted; // cycle of the grant
+    vluint64_t ready;    // first cycle in which the response can be sent
+    uint32_t rdata;
+} ext_slave_rsp_t;
+
+// Traffic counters
+typedef struct {
+    vluint64_t reads;
+    vluint64_t writes;
+    vluint64_t read_bytes;
+    vluint64_t write_bytes;
+    vluint64_t device_accesses; // accesses forwarded to attached devices
+    vluint64_t gnt_wait;        // cycles with a pending request not granted
+    vluint64_t latency;         // sum of the cycles from grant to response
+    vluint64_t max_outstanding;
+    vluint64_t first_cycle;     // first and last access
+    vluint64_t last_cycle;
+} ext_slave_stats_t;
+
+// Class definition
+class TbExtSlave
+{
+private:
+    // Attached device
+    typedef struct {
+        uint32_t base;
+        uint32_t size;
+        TbExtDevice *dev;
+    } range_t;
+
+    std::string name;
+    std::unordered_map<uint32_t, uint8_t *> pages;
+    std::vector<range_t> ranges;
+
+    // Latency configuration
+    unsigned int gnt_latency;    // wait states before each grant
+    unsigned int rvalid_latency; // cycles from the grant to the response (>= 1)
+    unsigned int depth;          // maximum outstanding requests
+
+    // Bus state
+    vluint64_t cycle;
+    bool gnt_q;                  // grant (OBI) or ready (register interface) driven in this cycle
+    unsigned int wait;           // cycles the current request has been waiting
+    unsigned int extra;          // device latency of the current register access
+    uint32_t reg_rdata;
+    std::deque<ext_slave_rsp_t> rsp;
+
+    ext_slave_stats_t stats;
+
+    // Perform an access, returning the additional latency
+    unsigned int access(bool we, uint8_t be, uint32_t addr, uint32_t wdata, uint32_t &rdata);
+    void reset();
+    void tick();
+public:
+    TbExtSlave(const std::string &name);
+    ~TbExtSlave();
+
+    // Set the grant and response latencies and the outstanding requests
+    void setLatency(unsigned int gnt_latency, unsigned int rvalid_latency, unsigned int depth);
+
+    // Forward the accesses to [base, base + size) to dev (the slave takes
+    // ownership of the device)
+    void attach(uint32_t base, uint32_t size, TbExtDevice *dev);
+
+    // Process a rising edge of the clock, given the request of the cycle that
+    // ends. Return the grant and response of the next cycle.
+    void evalObi(bool rst_n, bool req, bool we, uint8_t be, uint32_t addr, uint32_t wdata, bool &gnt,
+                 bool &rvalid, uint32_t &rdata);
+    void evalReg(bool rst_n, bool valid, bool write, uint8_t wstrb, uint32_t addr, uint32_t wdata, bool &ready,
+                 uint32_t &rdata);
+
+    // Access the sparse memory (e.g., from a device model or to preload data)
+    uint32_t readWord(uint32_t addr);
+    void writeWord(uint32_t addr, uint32_t data, uint8_t be = 0xf);
+
+    const std::string &getName();
+    const ext_slave_stats_t &getStats();
+
+    // Print the traffic counters and write them as a JSON object
+    void printStats();
+    void writeStats(FILE *fp, const char *indent);
+
+#ifdef TB_CHECKPOINT_EN
+    // Save and restore the bus state, the pending responses, the counters, the
+    // sparse memory and the state of the attached devices
+    void save(VerilatedSerialize &os);
+    bool restore(VerilatedDeserialize &is);
+#endif
+};
+
+// Slave models instantiated by the RTL (in creation order)
+const std::vector<TbExtSlave *> &tbExtSlaveModels();
+
+// Attach a device model to the slave with the given name (ext_slave_<N>,
+// ext_periph) as soon as it is created. The range is given in bus addresses.
+// Can be called from the initializer of a static variable, so that a device
+// model only requires adding its source file to the tb-verilator fileset:
+//   static bool my_accel = tbExtSlaveAttach("ext_slave_1", 0xF0010000, 0x1000, new MyAccel());
+bool tbExtSlaveAttach(const std::string &slave, uint32_t base, uint32_t size, TbExtDevice *dev);
+
+#endif // TB_EXT_SLAVE_HH_
@@ -0,0 +1,748 @@
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <svdpi.h>
+
+#include "tb_flash.hh"
+#include "tb_elf.hh"
+#include "tb_loader.hh"
+#include "tb_macros.hh"
+
+// Flash commands
+#define FLASH_CMD_WRSR1     0x01
+#define FLASH_CMD_PP        0x02
+#define FLASH_CMD_READ      0x03
+#define FLASH_CMD_WRDI      0x04
+#define FLASH_CMD_RDSR1     0x05
+#define FLASH_CMD_WREN      0x06
+#define FLASH_CMD_FAST_READ 0x0B
+#define FLASH_CMD_WRSR3     0x11
+#define FLASH_CMD_RDSR3     0x15
+#define FLASH_CMD_SE        0x20
+#define FLASH_CMD_WRSR2     0x31
+#define FLASH_CMD_QPP       0x32
+#define FLASH_CMD_RDSR2     0x35
+#define FLASH_CMD_DOR       0x3B
+#define FLASH_CMD_VWREN     0x50
+#define FLASH_CMD_BE32      0x52
+#define FLASH_CMD_CE_ALT    0x60
+#define FLASH_CMD_RSTEN     0x66
+#define FLASH_CMD_QOR       0x6B
+#define FLASH_CMD_RDID      0x90
+#define FLASH_CMD_RST       0x99
+#define FLASH_CMD_JEDEC_ID  0x9F
+#define FLASH_CMD_RPD       0xAB
+#define FLASH_CMD_PD        0xB9
+#define FLASH_CMD_DIOR      0xBB
+#define FLASH_CMD_CE        0xC7
+#define FLASH_CMD_BE64      0xD8
+#define FLASH_CMD_QIOR      0xEB
+#define FLASH_CMD_MBR       0xFF
+
+// Status register 1 bits
+#define FLASH_SR1_BUSY 0x01
+#define FLASH_SR1_WEL  0x02
+
+// W25Q128JW identification
+static const uint8_t flash_jedec_id[] = {0xEF, 0x60, 0x18};
+static const uint8_t flash_device_id = 0x17;
+
+static const char *flash_mode_names[FLASH_MODE_NUM] = {"std", "dual", "quad"};
+
+// Flash models created by the RTL
+static std::vector<TbFlash *> flash_models;
+
+const std::vector<TbFlash *> &tbFlashModels()
+{
+    return flash_models;
+}
+
+// Number of data lines of a transfer mode
+static inline unsigned int modeLines(flash_mode_t mode)
+{
+    return 1U << mode;
+}
+
+TbFlash::TbFlash(const std::string &name)
+{
+    this->name = name;
+    this->mem = NULL;
+    this->dummy_cycles = TB_FLASH_DUMMY_CYCLES;
+    this->prog_cycles = 0;
+    this->erase_cycles = 0;
+    this->powered_up = true;
+    this->wel = false;
+    this->reset_en = false;
+    this->sr2 = 0;
+    this->sr3 = 0;
+    this->xip_cmd = 0;
+    this->busy_until = 0;
+    this->csb_q = true;
+    this->clk_q = false;
+    this->phase = FLASH_PH_CMD;
+    this->in_mode = FLASH_MODE_STD;
+    this->out_mode = FLASH_MODE_STD;
+    this->cmd = 0;
+    this->addr = 0;
+    this->addr_bytes = 0;
+    this->dummy_left = 0;
+    this->rx = 0;
+    this->rx_bits = 0;
+    this->tx = 0;
+    this->tx_bits = 0;
+    this->out = 0;
+    this->erase_size = 0;
+    this->wsr = false;
+    this->programmed = false;
+    memset(&this->stats, 0, sizeof(this->stats));
+}
+
+TbFlash::~TbFlash()
+{
+    if (this->mem != NULL) munmap(this->mem, TB_FLASH_SIZE);
+}
+
+bool TbFlash::open(const std::string &image)
+{
+    this->image = image;
+
+    // Erased memory array (pages are only committed when a sector is loaded)
+    void *p = mmap(NULL, TB_FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) {
+        TB_ERR("Cannot allocate SPI flash '%s': %s", this->name.c_str(), strerror(errno));
+        return false;
+    }
+    this->mem = (uint8_t *)p;
+    this->loaded.assign(TB_FLASH_SIZE / TB_FLASH_SECTOR_SIZE, false);
+    this->dirty.assign(TB_FLASH_SIZE / TB_FLASH_SECTOR_SIZE, false);
+    if (image.empty()) return true;
+
+    // Binary image: map the file on top of the array. Programs and erases
+    // are copy-on-write and never modify the file.
+    if (image.size() > 4 && image.compare(image.size() - 4, 4, ".bin") == 0) {
+        struct stat st;
+        int fd = ::open(image.c_str(), O_RDONLY);
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            TB_ERR("Cannot open SPI flash image '%s': %s", image.c_str(), strerror(errno));
+            if (fd >= 0) ::close(fd);
+            return false;
+        }
+        size_t size = std::min((size_t)st.st_size, (size_t)TB_FLASH_SIZE);
+        if (size > 0) {
+            p = mmap(this->mem, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0);
+            if (p == MAP_FAILED) {
+                TB_ERR("Cannot map SPI flash image '%s': %s", image.c_str(), strerror(errno));
+                ::close(fd);
+                return false;
+            }
+            // The rest of the last page reads as erased (0xff)
+            size_t page = sysconf(_SC_PAGESIZE);
+            size_t mapped = std::min((size + page - 1) & ~(page - 1), (size_t)TB_FLASH_SIZE);
+            memset(this->mem + size, 0xff, mapped - size);
+            std::fill(this->loaded.begin(), this->loaded.begin() + mapped / TB_FLASH_SECTOR_SIZE, true);
+        }
+        ::close(fd);
+        if ((size_t)st.st_size > TB_FLASH_SIZE) {
+            TB_WARN("SPI flash image '%s' truncated to %u bytes", image.c_str(), TB_FLASH_SIZE);
+        }
+        return true;
+    }
+
+    // ELF or Verilog HEX image: addresses are taken modulo the flash size
+    // (e.g., the flash_load and flash_exec ELF files are linked at the flash
+    // base address in the memory map)
+    auto write = [this](uint32_t addr, const uint8_t *data, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            uint32_t a = (addr + i) & (TB_FLASH_SIZE - 1);
+            this->loadSector(a / TB_FLASH_SECTOR_SIZE);
+            this->mem[a] = data[i];
+        }
+    };
+    if (isElfFile(image)) {
+        TbElf elf;
+        if (!elf.open(image)) return false;
+        std::vector<tb_elf_segment_t> segments = elf.getLoadSegments();
+        for (size_t i = 0; i < segments.size(); i++) {
+            write(segments[i].addr, segments[i].data, segments[i].size);
+        }
+        return true;
+    }
+    return readVerilogHex(image, write);
+}
+
+void TbFlash::setLatency(unsigned int dummy_cycles, unsigned int prog_cycles, unsigned int erase_cycles)
+{
+    this->dummy_cycles = dummy_cycles;
+    this->prog_cycles = prog_cycles;
+    this->erase_cycles = erase_cycles;
+}
+
+uint8_t TbFlash::eval(bool csb, bool clk, uint8_t io)
+{
+    if (csb != this->csb_q) {
+        if (csb) this->end();
+        else this->begin();
+    } else if (!csb && clk != this->clk_q) {
+        // SPI mode 0: sample on the rising edge, drive on the falling edge
+        if (clk) this->sample(io);
+        else this->drive();
+    }
+    this->csb_q = csb;
+    this->clk_q = clk;
+    return this->out;
+}
+
+const std::string &TbFlash::getName()
+{
+    return this->name;
+}
+
+const flash_stats_t &TbFlash::getStats()
+{
+    return this->stats;
+}
+
+void TbFlash::printStats()
+{
+    vluint64_t read_bytes = 0;
+    vluint64_t prog_bytes = 0;
+    for (int m = 0; m < FLASH_MODE_NUM; m++) {
+        read_bytes += this->stats.read_bytes[m];
+        prog_bytes += this->stats.prog_bytes[m];
+    }
+    if (this->stats.sck_cycles == 0) return;
+
+    TB_LOG(LOG_LOW, "SPI flash '%s': %lu SCK cycles, %lu bytes read, %lu bytes programmed, %lu bytes erased",
+           this->name.c_str(), this->stats.sck_cycles, read_bytes, prog_bytes, this->stats.erase_bytes);
+    for (int m = 0; m < FLASH_MODE_NUM; m++) {
+        if (this->stats.read_cmds[m] == 0 && this->stats.prog_cmds[m] == 0) continue;
+        TB_LOG(LOG_LOW, "- %-4s: %lu reads (%lu bytes), %lu page programs (%lu bytes)", flash_mode_names[m],
+               this->stats.read_cmds[m], this->stats.read_bytes[m], this->stats.prog_cmds[m],
+               this->stats.prog_bytes[m]);
+    }
+    if (this->stats.xip_reads != 0) {
+        TB_LOG(LOG_LOW, "- %lu reads in continuous read mode", this->stats.xip_reads);
+    }
+    for (int c = 0; c < 256; c++) {
+        if (this->stats.cmds[c] != 0) TB_LOG(LOG_MEDIUM, "- command 0x%02x: %lu", c, this->stats.cmds[c]);
+    }
+}
+
+void TbFlash::writeStats(FILE *fp, const char *indent)
+{
+    fprintf(fp, "{\n");
+    fprintf(fp, "%s  \"sck_cycles\": %lu,\n", indent, this->stats.sck_cycles);
+    fprintf(fp, "%s  \"read\": {", indent);
+    for (int m = 0; m < FLASH_MODE_NUM; m++) {
+        fprintf(fp, "%s\"%s\": {\"cmds\": %lu, \"bytes\": %lu}", m ? ", " : "", flash_mode_names[m],
+                this->stats.read_cmds[m], this->stats.read_bytes[m]);
+    }
+    fprintf(fp, "},\n");
+    fprintf(fp, "%s  \"program\": {", indent);
+    for (int m = 0; m < FLASH_MODE_NUM; m++) {
+        fprintf(fp, "%s\"%s\": {\"cmds\": %lu, \"bytes\": %lu}", m ? ", " : "", flash_mode_names[m],
+                this->stats.prog_cmds[m], this->stats.prog_bytes[m]);
+    }
+    fprintf(fp, "},\n");
+    fprintf(fp, "%s  \"xip_reads\": %lu,\n", indent, this->stats.xip_reads);
+    fprintf(fp, "%s  \"erase_bytes\": %lu,\n", indent, this->stats.erase_bytes);
+    fprintf(fp, "%s  \"commands\": {", indent);
+    bool first = true;
+    for (int c = 0; c < 256; c++) {
+        if (this->stats.cmds[c] == 0) continue;
+        fprintf(fp, "%s\"0x%02x\": %lu", first ? "" : ", ", c, this->stats.cmds[c]);
+        first = false;
+    }
+    fprintf(fp, "}\n");
+    fprintf(fp, "%s}", indent);
+}
+
+vluint64_t TbFlash::now()
+{
+    // Two time units per system clock cycle (see runCycles())
+    return Verilated::threadContextp()->time() >> 1;
+}
+
+bool TbFlash::busy()
+{
+    return this->now() < this->busy_until;
+}
+
+void TbFlash::loadSector(uint32_t sector)
+{
+    if (this->loaded[sector]) return;
+    memset(this->mem + sector * TB_FLASH_SECTOR_SIZE, 0xff, TB_FLASH_SECTOR_SIZE);
+    this->loaded[sector] = true;
+}
+
+void TbFlash::begin()
+{
+    this->rx = 0;
+    this->rx_bits = 0;
+    this->tx_bits = 0;
+    this->addr = 0;
+    this->addr_bytes = 0;
+    this->erase_size = 0;
+    this->wsr = false;
+    this->programmed = false;
+    this->out = 0;
+
+    // Continuous read mode: the transaction starts with the address
+    if (this->xip_cmd != 0) {
+        this->cmd = this->xip_cmd;
+        this->phase = FLASH_PH_ADDR;
+        this->in_mode = this->xip_cmd == FLASH_CMD_QIOR ? FLASH_MODE_QUAD : FLASH_MODE_DUAL;
+        this->out_mode = this->in_mode;
+        this->stats.read_cmds[this->out_mode]++;
+        this->stats.xip_reads++;
+        return;
+    }
+    this->cmd = 0;
+    this->phase = FLASH_PH_CMD;
+    this->in_mode = FLASH_MODE_STD;
+    this->out_mode = FLASH_MODE_STD;
+}
+
+void TbFlash::end()
+{
+    // A continuous read ended before the mode bits (e.g., 0xFF on IO0) exits
+    // the continuous read mode
+    if (this->xip_cmd != 0 && (this->phase == FLASH_PH_ADDR || this->phase == FLASH_PH_MODE)) {
+        this->xip_cmd = 0;
+    }
+
+    // Programs and erases start when the chip select is deasserted
+    if (this->erase_size != 0 && this->wel && (this->erase_size == TB_FLASH_SIZE || this->addr_bytes == 3)) {
+        uint32_t base = this->addr & ~(this->erase_size - 1);
+        std::fill(this->loaded.begin() + base / TB_FLASH_SECTOR_SIZE,
+                  this->loaded.begin() + (base + this->erase_size) / TB_FLASH_SECTOR_SIZE, false);
+        std::fill(this->dirty.begin() + base / TB_FLASH_SECTOR_SIZE,
+                  this->dirty.begin() + (base + this->erase_size) / TB_FLASH_SECTOR_SIZE, true);
+        this->stats.erase_bytes += this->erase_size;
+        this->busy_until = this->now() + (vluint64_t)this->erase_cycles * (this->erase_size / TB_FLASH_SECTOR_SIZE);
+        this->wel = false;
+    }
+    if (this->programmed) {
+        this->busy_until = this->now() + this->prog_cycles;
+        this->wel = false;
+    }
+    if (this->wsr) this->wel = false;
+
+    this->phase = FLASH_PH_CMD;
+    this->out = 0;
+}
+
+void TbFlash::sample(uint8_t io)
+{
+    this->stats.sck_cycles++;
+
+    switch (this->phase) {
+    case FLASH_PH_CMD:
+    case FLASH_PH_ADDR:
+    case FLASH_PH_MODE:
+    case FLASH_PH_PROG:
+    case FLASH_PH_WSR: {
+        // The MSB is on the highest data line (IO0 in standard mode)
+        unsigned int n = modeLines(this->in_mode);
+        this->rx = (this->rx << n) | (io & ((1U << n) - 1));
+        this->rx_bits += n;
+        if (this->rx_bits == 8) {
+            this->rx_bits = 0;
+            this->byteReceived(this->rx);
+        }
+        break;
+    }
+    case FLASH_PH_DUMMY:
+        if (--this->dummy_left == 0) this->startOutput();
+        break;
+    default:
+        break;
+    }
+}
+
+void TbFlash::drive()
+{
+    if (this->phase != FLASH_PH_READ && this->phase != FLASH_PH_REG) {
+        this->out = 0;
+        return;
+    }
+
+    // Load the next byte
+    if (this->tx_bits == 0) {
+        if (this->phase == FLASH_PH_READ) {
+            this->tx = this->readByte(this->addr);
+            this->addr = (this->addr + 1) & (TB_FLASH_SIZE - 1);
+        } else {
+            this->tx = this->regByte();
+        }
+        this->tx_bits = 8;
+    }
+
+    // Shift out the next bits (on IO1 in standard mode)
+    unsigned int n = modeLines(this->out_mode);
+    uint8_t bits = this->tx >> (8 - n);
+    this->tx <<= n;
+    this->tx_bits -= n;
+    if (this->tx_bits == 0 && this->phase == FLASH_PH_READ) this->stats.read_bytes[this->out_mode]++;
+    if (this->out_mode == FLASH_MODE_STD) this->out = 0x20 | (bits << 1);
+    else this->out = (((1U << n) - 1) << 4) | bits;
+}
+
+void TbFlash::command(uint8_t cmd)
+{
+    bool reset_en = this->reset_en;
+
+    this->cmd = cmd;
+    this->reset_en = false;
+    this->stats.cmds[cmd]++;
+
+    // Only the release from power-down is accepted in power-down mode, and
+    // only the status registers can be read during a program or erase
+    if (!this->powered_up && cmd != FLASH_CMD_RPD) {
+        this->phase = FLASH_PH_IGNORE;
+        return;
+    }
+    if (this->busy() && cmd != FLASH_CMD_RDSR1 && cmd != FLASH_CMD_RDSR2 && cmd != FLASH_CMD_RDSR3) {
+        TB_LOG(LOG_HIGH, "SPI flash '%s': command 0x%02x ignored (busy)", this->name.c_str(), cmd);
+        this->phase = FLASH_PH_IGNORE;
+        return;
+    }
+
+    this->phase = FLASH_PH_ADDR;
+    switch (cmd) {
+    // Reads (address mode, data mode)
+    case FLASH_CMD_READ:
+    case FLASH_CMD_FAST_READ:
+        this->stats.read_cmds[FLASH_MODE_STD]++;
+        break;
+    case FLASH_CMD_DOR:
+        this->out_mode = FLASH_MODE_DUAL;
+        this->stats.read_cmds[FLASH_MODE_DUAL]++;
+        break;
+    case FLASH_CMD_QOR:
+        this->out_mode = FLASH_MODE_QUAD;
+        this->stats.read_cmds[FLASH_MODE_QUAD]++;
+        break;
+    case FLASH_CMD_DIOR:
+        this->in_mode = FLASH_MODE_DUAL;
+        this->out_mode = FLASH_MODE_DUAL;
+        this->stats.read_cmds[FLASH_MODE_DUAL]++;
+        break;
+    case FLASH_CMD_QIOR:
+        this->in_mode = FLASH_MODE_QUAD;
+        this->out_mode = FLASH_MODE_QUAD;
+        this->stats.read_cmds[FLASH_MODE_QUAD]++;
+        break;
+
+    // Programs and erases (the address is always sent in standard mode)
+    case FLASH_CMD_PP:
+    case FLASH_CMD_QPP:
+        if (!this->wel) this->phase = FLASH_PH_IGNORE;
+        else this->stats.prog_cmds[cmd == FLASH_CMD_QPP ? FLASH_MODE_QUAD : FLASH_MODE_STD]++;
+        break;
+    case FLASH_CMD_SE:
+        this->erase_size = TB_FLASH_SECTOR_SIZE;
+        break;
+    case FLASH_CMD_BE32:
+        this->erase_size = 32 * 1024;
+        break;
+    case FLASH_CMD_BE64:
+        this->erase_size = 64 * 1024;
+        break;
+    case FLASH_CMD_CE:
+    case FLASH_CMD_CE_ALT:
+        this->erase_size = TB_FLASH_SIZE;
+        this->phase = FLASH_PH_IGNORE;
+        break;
+    case FLASH_CMD_RDID:
+        break;
+
+    // Status registers and identification
+    case FLASH_CMD_RDSR1:
+    case FLASH_CMD_RDSR2:
+    case FLASH_CMD_RDSR3:
+    case FLASH_CMD_JEDEC_ID:
+        this->startOutput();
+        break;
+    case FLASH_CMD_WRSR1:
+    case FLASH_CMD_WRSR2:
+    case FLASH_CMD_WRSR3:
+        this->phase = FLASH_PH_WSR;
+        break;
+    case FLASH_CMD_WREN:
+    case FLASH_CMD_VWREN:
+        this->wel = true;
+        this->phase = FLASH_PH_IGNORE;
+        break;
+    case FLASH_CMD_WRDI:
+        this->wel = false;
+        this->phase = FLASH_PH_IGNORE;
+        break;
+
+    // Power and reset
+    case FLASH_CMD_RPD:
+        // Optionally followed by three dummy bytes and the device ID
+        this->powered_up = true;
+        break;
+    case FLASH_CMD_PD:
+        this->powered_up = false;
+        this->phase = FLASH_PH_IGNORE;
+        break;
+    case FLASH_CMD_RSTEN:
+        this->reset_en = true;
+        this->phase = FLASH_PH_IGNORE;
+        break;
+    case FLASH_CMD_RST:
+        if (reset_en) {
+            this->wel = false;
+            this->xip_cmd = 0;
+            this->busy_until = 0;
+        }
+        this->phase = FLASH_PH_IGNORE;
+        break;
+    case FLASH_CMD_MBR:
+        this->phase = FLASH_PH_IGNORE;
+        break;
+
+    default:
+        if (this->stats.cmds[cmd] == 1) {
+            TB_WARN("SPI flash '%s': unsupported command 0x%02x ignored", this->name.c_str(), cmd);
+        }
+        this->phase = FLASH_PH_IGNORE;
+        break;
+    }
+}
+
+void TbFlash::byteReceived(uint8_t data)
+{
+    switch (this->phase) {
+    case FLASH_PH_CMD:
+        this->command(data);
+        break;
+
+    case FLASH_PH_ADDR:
+        this->addr = (this->addr << 8) | data;
+        if (++this->addr_bytes < 3) break;
+        this->addr &= TB_FLASH_SIZE - 1;
+        switch (this->cmd) {
+        case FLASH_CMD_READ:
+        case FLASH_CMD_RDID:
+        case FLASH_CMD_RPD:
+            this->startOutput();
+            break;
+        case FLASH_CMD_FAST_READ:
+        case FLASH_CMD_DOR:
+        case FLASH_CMD_QOR:
+            this->phase = FLASH_PH_DUMMY;
+            this->dummy_left = this->dummy_cycles;
+            if (this->dummy_left == 0) this->startOutput();
+            break;
+        case FLASH_CMD_DIOR:
+        case FLASH_CMD_QIOR:
+            this->phase = FLASH_PH_MODE;
+            break;
+        case FLASH_CMD_PP:
+        case FLASH_CMD_QPP:
+            this->phase = FLASH_PH_PROG;
+            this->in_mode = this->cmd == FLASH_CMD_QPP ? FLASH_MODE_QUAD : FLASH_MODE_STD;
+            break;
+        default:
+            // Erases: executed at the end of the transaction
+            this->phase = FLASH_PH_IGNORE;
+            break;
+        }
+        break;
+
+    case FLASH_PH_MODE:
+        // M5-4 = 10: continuous read mode
+        this->xip_cmd = (data & 0x30) == 0x20 ? this->cmd : 0;
+        this->phase = FLASH_PH_DUMMY;
+        this->dummy_left = this->dummy_cycles;
+        if (this->dummy_left == 0) this->startOutput();
+        break;
+
+    case FLASH_PH_PROG:
+        // Bits can only be cleared, and the address wraps within the page
+        this->loadSector(this->addr / TB_FLASH_SECTOR_SIZE);
+        this->mem[this->addr] &= data;
+        this->dirty[this->addr / TB_FLASH_SECTOR_SIZE] = true;
+        this->addr = (this->addr & ~(TB_FLASH_PAGE_SIZE - 1)) | ((this->addr + 1) & (TB_FLASH_PAGE_SIZE - 1));
+        this->stats.prog_bytes[this->in_mode]++;
+        this->programmed = true;
+        break;
+
+    case FLASH_PH_WSR:
+        // The block protection bits (status register 1) are not modeled. The
+        // quad enable bit (status register 2) is stored but not enforced.
+        if (this->wel) {
+            if (this->cmd == FLASH_CMD_WRSR2 || (this->cmd == FLASH_CMD_WRSR1 && this->addr_bytes == 1)) {
+                this->sr2 = data;
+            } else if (this->cmd == FLASH_CMD_WRSR3) {
+                this->sr3 = data;
+            }
+            this->wsr = true;
+        }
+        this->addr_bytes++;
+        break;
+
+    default:
+        break;
+    }
+}
+
+void TbFlash::startOutput()
+{
+    switch (this->cmd) {
+    case FLASH_CMD_RDSR1:
+    case FLASH_CMD_RDSR2:
+    case FLASH_CMD_RDSR3:
+    case FLASH_CMD_JEDEC_ID:
+    case FLASH_CMD_RDID:
+    case FLASH_CMD_RPD:
+        this->phase = FLASH_PH_REG;
+        if (this->cmd == FLASH_CMD_JEDEC_ID) this->addr = 0;
+        break;
+    default:
+        this->phase = FLASH_PH_READ;
+        break;
+    }
+    this->tx_bits = 0;
+}
+
+uint8_t TbFlash::regByte()
+{
+    // The status registers are read continuously, the IDs are read in a loop
+    // (using the address as index)
+    switch (this->cmd) {
+    case FLASH_CMD_RDSR1:
+        return (this->busy() ? FLASH_SR1_BUSY | FLASH_SR1_WEL : 0) | (this->wel ? FLASH_SR1_WEL : 0);
+    case FLASH_CMD_RDSR2:
+        return this->sr2;
+    case FLASH_CMD_RDSR3:
+        return this->sr3;
+    case FLASH_CMD_JEDEC_ID:
+        return flash_jedec_id[this->addr++ % sizeof(flash_jedec_id)];
+    case FLASH_CMD_RDID:
+        return (this->addr++ & 0x1) ? flash_device_id : flash_jedec_id[0];
+    default:
+        return flash_device_id;
+    }
+}
+
+#ifdef TB_CHECKPOINT_EN
+void TbFlash::save(VerilatedSerialize &os)
+{
+    uint32_t n = std::count(this->dirty.begin(), this->dirty.end(), true);
+    uint32_t phase = this->phase, in_mode = this->in_mode, out_mode = this->out_mode;
+    std::vector<uint8_t> erased(TB_FLASH_SECTOR_SIZE, 0xff);
+
+    os << this->name << this->image;
+
+    // Device state
+    os << this->powered_up << this->wel << this->reset_en << this->sr2 << this->sr3 << this->xip_cmd;
+    os << this->busy_until;
+
+    // Transaction state
+    os << this->csb_q << this->clk_q << phase << in_mode << out_mode << this->cmd << this->addr << this->addr_bytes
+       << this->dummy_left;
+    os << this->rx << this->rx_bits << this->tx << this->tx_bits << this->out << this->erase_size << this->wsr
+       << this->programmed;
+    os.write(&this->stats, sizeof(this->stats));
+
+    // Programmed or erased sectors
+    os << n;
+    for (uint32_t s = 0; s < this->dirty.size(); s++) {
+        if (!this->dirty[s]) continue;
+        os << s;
+        if (this->loaded[s]) {
+            os.write(this->mem + s * TB_FLASH_SECTOR_SIZE, TB_FLASH_SECTOR_SIZE);
+        } else {
+            os.write(erased.data(), TB_FLASH_SECTOR_SIZE);
+        }
+    }
+}
+
+bool TbFlash::restore(VerilatedDeserialize &is)
+{
+    std::string name, image;
+    uint32_t phase, in_mode, out_mode, n, s;
+
+    is >> name >> image;
+    if (name != this->name) {
+        TB_ERR("Checkpoint of SPI flash '%s' restored into '%s'", name.c_str(), this->name.c_str());
+        return false;
+    }
+    if (image != this->image) {
+        TB_WARN("SPI flash '%s': checkpoint saved with image '%s', restored with '%s'", name.c_str(),
+                image.c_str(), this->image.c_str());
+    }
+
+    // Device state
+    is >> this->powered_up >> this->wel >> this->reset_en >> this->sr2 >> this->sr3 >> this->xip_cmd;
+    is >> this->busy_until;
+
+    // Transaction state
+    is >> this->csb_q >> this->clk_q >> phase >> in_mode >> out_mode >> this->cmd >> this->addr >>
+        this->addr_bytes >> this->dummy_left;
+    is >> this->rx >> this->rx_bits >> this->tx >> this->tx_bits >> this->out >> this->erase_size >> this->wsr >>
+        this->programmed;
+    this->phase = (flash_phase_t)phase;
+    this->in_mode = (flash_mode_t)in_mode;
+    this->out_mode = (flash_mode_t)out_mode;
+    is.read(&this->stats, sizeof(this->stats));
+
+    // Programmed or erased sectors, on top of the image
+    is >> n;
+    for (uint32_t i = 0; i < n; i++) {
+        is >> s;
+        if (s >= this->dirty.size()) {
+            TB_ERR("SPI flash '%s': invalid sector %u in the checkpoint", name.c_str(), s);
+            return false;
+        }
+        is.read(this->mem + s * TB_FLASH_SECTOR_SIZE, TB_FLASH_SECTOR_SIZE);
+        this->loaded[s] = true;
+        this->dirty[s] = true;
+    }
+    return true;
+}
+#endif // TB_CHECKPOINT_EN
+
+// DPI functions (see tb/spiflashdpi.sv)
+// -------------------------------------
+extern "C" void *spiflashdpi_create(const char *name, const char *image, int dummy_cycles, int prog_cycles,
+                                    int erase_cycles)
+{
+    TbFlash *flash = new TbFlash(name);
+    if (!flash->open(image)) {
+        delete flash;
+        exit(EXIT_FAILURE);
+    }
+    flash->setLatency(dummy_cycles, prog_cycles, erase_cycles);
+    flash_models.push_back(flash);
+
+    TB_CONFIG("SPI flash '%s': %s, %d dummy cycles, %d/%d program/erase busy cycles", name,
+              image[0] != '\0' ? image : "erased", dummy_cycles, prog_cycles, erase_cycles);
+    return flash;
+}
+
+extern "C" void spiflashdpi_close(void *ctx)
+{
+    TbFlash *flash = (TbFlash *)ctx;
+    if (flash == NULL) return;
+    flash->printStats();
+    flash_models.erase(std::remove(flash_models.begin(), flash_models.end(), flash), flash_models.end());
+    delete flash;
+}
+
+extern "C" char spiflashdpi_eval(void *ctx, svBit csb, svBit clk, char io)
+{
+    TbFlash *flash = (TbFlash *)ctx;
+    if (flash == NULL) return 0;
+    return (char)flash->eval(csb, clk, (uint8_t)io);
+}
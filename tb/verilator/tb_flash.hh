@@ -0,0 +1,166 @@
+// Copyright 2026 EPFL and Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_flash.hh
+// Author: agent
+// Date: 16/10/2026
+// Description: Behavioral model of the W25Q128JW SPI flash, connected to the
+//              RTL through the spiflashdpi module
+
+#if !defined(TB_FLASH_HH_)
+#define TB_FLASH_HH_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <verilated.h>
+#ifdef TB_CHECKPOINT_EN
+#include <verilated_save.h>
+#endif
+
+// Flash geometry
+#define TB_FLASH_SIZE (16 * 1024 * 1024)
+#define TB_FLASH_PAGE_SIZE 256
+#define TB_FLASH_SECTOR_SIZE 4096
+
+// Default number of dummy cycles of the fast read commands (the BSP and the
+// SPI memory-mapped controller use 8 in simulation)
+#define TB_FLASH_DUMMY_CYCLES 8
+
+// Data transfer mode (number of data lines)
+typedef enum {
+    FLASH_MODE_STD = 0,
+    FLASH_MODE_DUAL,
+    FLASH_MODE_QUAD,
+    FLASH_MODE_NUM
+} flash_mode_t;
+
+// Transaction phase
+typedef enum {
+    FLASH_PH_CMD = 0,
+    FLASH_PH_ADDR,
+    FLASH_PH_MODE,   // continuous read mode bits
+    FLASH_PH_DUMMY,
+    FLASH_PH_READ,   // memory array output
+    FLASH_PH_PROG,   // page program input
+    FLASH_PH_WSR,    // status register input
+    FLASH_PH_REG,    // status register or ID output
+    FLASH_PH_IGNORE  // ignore the rest of the transaction
+} flash_phase_t;
+
+// Traffic counters
+typedef struct {
+    vluint64_t cmds[256];                 // commands per opcode
+    vluint64_t read_cmds[FLASH_MODE_NUM]; // read commands per data mode
+    vluint64_t read_bytes[FLASH_MODE_NUM];
+    vluint64_t prog_cmds[FLASH_MODE_NUM]; // page program commands per data mode
+    vluint64_t prog_bytes[FLASH_MODE_NUM];
+    vluint64_t xip_reads;                 // reads in continuous read mode (no opcode)
+    vluint64_t erase_bytes;
+    vluint64_t sck_cycles;
+} flash_stats_t;
+
+// Class definition
+class TbFlash
+{
+private:
+    std::string name;
+    uint8_t *mem; // memory array (anonymous mapping, image file mapped on top)
+    std::string image;
+    std::vector<bool> loaded; // sectors with valid data in mem (the others are erased)
+    std::vector<bool> dirty;  // sectors programmed or erased since open()
+
+    // Latency configuration
+    unsigned int dummy_cycles; // fast read dummy cycles
+    unsigned int prog_cycles;  // page program busy time (system clock cycles)
+    unsigned int erase_cycles; // sector erase busy time (system clock cycles)
+
+    // Device state
+    bool powered_up;
+    bool wel;               // write enable latch
+    bool reset_en;          // reset enable (0x66) received
+    uint8_t sr2;            // status register 2 (QE, etc.)
+    uint8_t sr3;            // status register 3
+    uint8_t xip_cmd;        // read command of the continuous read mode (0: off)
+    vluint64_t busy_until;  // end of the current program or erase (system cycle)
+
+    // Transaction state
+    bool csb_q;
+    bool clk_q;
+    flash_phase_t phase;
+    flash_mode_t in_mode;
+    flash_mode_t out_mode;
+    uint8_t cmd;
+    uint32_t addr;
+    unsigned int addr_bytes; // address bytes received
+    unsigned int dummy_left;
+    uint8_t rx;              // input shift register
+    unsigned int rx_bits;
+    uint8_t tx;              // output shift register
+    unsigned int tx_bits;
+    uint8_t out;             // output enables (bits 7:4) and values (bits 3:0)
+    uint32_t erase_size;     // erase to perform at the end of the transaction
+    bool wsr;                // status register written by the transaction
+    bool programmed;         // page programmed by the transaction
+
+    flash_stats_t stats;
+
+    // Current system clock cycle
+    vluint64_t now();
+    bool busy();
+
+    // Memory array access. Erased sectors are only filled with 0xff when
+    // first written, so that untouched ones never commit memory.
+    inline uint8_t readByte(uint32_t addr)
+    {
+        return this->loaded[addr / TB_FLASH_SECTOR_SIZE] ? this->mem[addr] : 0xff;
+    }
+    void loadSector(uint32_t sector);
+
+    // Transaction handling
+    void begin();
+    void end();
+    void sample(uint8_t io);
+    void drive();
+    void command(uint8_t cmd);
+    void byteReceived(uint8_t data);
+    void startOutput();
+    uint8_t regByte();
+public:
+    TbFlash(const std::string &name);
+    ~TbFlash();
+
+    // Allocate the memory array and load the image (empty: erased flash).
+    // Binary images (.bin) are mapped copy-on-write, ELF and Verilog HEX
+    // images are placed at their address modulo the flash size.
+    bool open(const std::string &image);
+
+    // Set the fast read dummy cycles and the program and erase busy times
+    void setLatency(unsigned int dummy_cycles, unsigned int prog_cycles, unsigned int erase_cycles);
+
+    // Process a change of the chip select or clock. Returns the output enables
+    // (bits 7:4) and values (bits 3:0) of IO3-IO0.
+    uint8_t eval(bool csb, bool clk, uint8_t io);
+
+    const std::string &getName();
+    const flash_stats_t &getStats();
+
+    // Print the traffic counters and write them as a JSON object
+    void printStats();
+    void writeStats(FILE *fp, const char *indent);
+
+#ifdef TB_CHECKPOINT_EN
+    // Save and restore the device and transaction state, the counters and the
+    // sectors programmed or erased since open() (the rest of the memory array
+    // comes from the image opened by the restoring process)
+    void save(VerilatedSerialize &os);
+    bool restore(VerilatedDeserialize &is);
+#endif
+};
+
+// Flash models instantiated by the RTL (in creation order)
+const std::vector<TbFlash *> &tbFlashModels();
+
+#endif // TB_FLASH_HH_
@@ -0,0 +1,234 @@
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <verilated.h>
+#include <verilated_syms.h>
+#include <svdpi.h>
+
+#include "tb_loader.hh"
+#include "tb_elf.hh"
+#include "tb_macros.hh"
+
+TbLoader::TbLoader()
+{
+    memset(this->sram, 0, sizeof(this->sram));
+    this->bound = false;
+    this->words_written = 0;
+}
+
+TbLoader::~TbLoader()
+{
+}
+
+bool TbLoader::bind()
+{
+    for (size_t i = 0; i < TB_SRAM_NUM_BANKS; i++) {
+        const tb_sram_bank_t *bank = &tb_sram_banks[i];
+
+        // The memory array is public (see tb-waivers.vlt), so it is
+        // registered in the scope of its memory cell
+        const VerilatedScope *scope = (const VerilatedScope *)svGetScopeFromName(bank->scope);
+        if (scope == NULL) {
+            TB_WARN("Cannot find SRAM bank scope '%s'", bank->scope);
+            return false;
+        }
+        VerilatedVar *var = scope->varFind(TB_SRAM_VAR_NAME);
+        if (var == NULL || var->datap() == NULL) {
+            TB_WARN("Cannot find public array '%s' in '%s'", TB_SRAM_VAR_NAME, bank->scope);
+            return false;
+        }
+        if (var->totalSize() != bank->num_words * sizeof(uint32_t)) {
+            TB_WARN("Unexpected size of '%s.%s': %lu bytes", bank->scope, TB_SRAM_VAR_NAME, (size_t)var->totalSize());
+            return false;
+        }
+        this->sram[i] = (uint32_t *)var->datap();
+    }
+
+    this->bound = true;
+    return true;
+}
+
+bool TbLoader::load(const std::string &file)
+{
+    bool ret;
+
+    if (!this->bound) return false;
+    this->words_written = 0;
+
+    if (isElfFile(file)) ret = this->loadElf(file);
+    else ret = this->loadVerilogHex(file);
+
+    if (ret) TB_LOG(LOG_MEDIUM, "- %lu SRAM words written", this->words_written);
+    return ret;
+}
+
+size_t TbLoader::getWordsWritten()
+{
+    return this->words_written;
+}
+
+bool TbLoader::isBound()
+{
+    return this->bound;
+}
+
+uint32_t *TbLoader::wordPtr(uint32_t addr)
+{
+    uint32_t word_addr = addr >> 2;
+
+    // Find the bank (and word inside it) the address is mapped to
+    for (size_t b = 0; b < TB_SRAM_NUM_BANKS; b++) {
+        const tb_sram_bank_t *bank = &tb_sram_banks[b];
+        if (addr < bank->start_addr || addr >= bank->end_addr) continue;
+        if ((word_addr & ((1U << bank->il_level) - 1)) != bank->il_offset) continue;
+        return &this->sram[b][((word_addr - (bank->start_addr >> 2)) >> bank->il_level) % bank->num_words];
+    }
+    return NULL;
+}
+
+bool TbLoader::readWord(uint32_t addr, uint32_t &data)
+{
+    uint32_t *word = this->bound ? this->wordPtr(addr) : NULL;
+    if (word == NULL) return false;
+    data = *word;
+    return true;
+}
+
+bool TbLoader::writeWord(uint32_t addr, uint32_t data)
+{
+    uint32_t *word = this->bound ? this->wordPtr(addr) : NULL;
+    if (word == NULL) return false;
+    *word = data;
+    return true;
+}
+
+void TbLoader::writeBytes(uint32_t addr, const uint8_t *data, size_t size)
+{
+    size_t i = 0;
+
+    while (i < size) {
+        uint32_t a = addr + i;
+        uint32_t byte_off = a & 0x3;
+        size_t nbytes = 4 - byte_off;
+        if (nbytes > size - i) nbytes = size - i;
+
+        uint32_t *word = this->wordPtr(a);
+        if (word == NULL) {
+            TB_WARN("Firmware address 0x%08x is outside the SRAM: skipped", a);
+            i += nbytes;
+            continue;
+        }
+
+        // Merge partial words with the current content
+        uint32_t w = (nbytes == 4) ? 0 : *word;
+        for (size_t j = 0; j < nbytes; j++) {
+            w &= ~(0xffU << (8 * (byte_off + j)));
+            w |= (uint32_t)data[i + j] << (8 * (byte_off + j));
+        }
+        *word = w;
+        this->words_written++;
+        i += nbytes;
+    }
+}
+
+bool TbLoader::loadElf(const std::string &file)
+{
+    TbElf elf;
+    if (!elf.open(file)) return false;
+
+    std::vector<tb_elf_segment_t> segments = elf.getLoadSegments();
+    if (segments.empty()) {
+        TB_ERR("No loadable segments in '%s'", file.c_str());
+        return false;
+    }
+    for (size_t i = 0; i < segments.size(); i++) {
+        TB_LOG(LOG_HIGH, "- segment at 0x%08x (%lu bytes)", segments[i].addr, segments[i].size);
+        this->writeBytes(segments[i].addr, segments[i].data, segments[i].size);
+    }
+    return true;
+}
+
+// Parse a hexadecimal digit (-1 if invalid)
+static inline int hexDigit(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool TbLoader::loadVerilogHex(const std::string &file)
+{
+    return readVerilogHex(file, [this](uint32_t addr, const uint8_t *data, size_t size) {
+        this->writeBytes(addr, data, size);
+    });
+}
+
+bool readVerilogHex(const std::string &file, const tb_hex_write_t &write)
+{
+    struct stat st;
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        TB_ERR("Cannot open firmware file '%s': %s", file.c_str(), strerror(errno));
+        return false;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        TB_ERR("Cannot read firmware file '%s'", file.c_str());
+        close(fd);
+        return false;
+    }
+    const char *buf = (const char *)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (buf == MAP_FAILED) {
+        TB_ERR("Cannot map firmware file '%s': %s", file.c_str(), strerror(errno));
+        return false;
+    }
+
+    // Parse the file as produced by 'objcopy -O verilog': '@<address>' markers
+    // followed by whitespace-separated bytes. Contiguous bytes are collected
+    // and written in blocks.
+    const char *p = buf;
+    const char *end = buf + st.st_size;
+    uint32_t addr = 0;
+    uint32_t blk_addr = 0;
+    std::vector<uint8_t> blk;
+    bool ret = true;
+
+    while (p < end && ret) {
+        if (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+            p++;
+        } else if (*p == '/' && p + 1 < end && p[1] == '/') {
+            // Skip comment
+            while (p < end && *p != '\n') p++;
+        } else if (*p == '@') {
+            // New address: flush the current block
+            if (!blk.empty()) write(blk_addr, blk.data(), blk.size());
+            blk.clear();
+            addr = 0;
+            p++;
+            for (int d; p < end && (d = hexDigit(*p)) >= 0; p++) addr = (addr << 4) | d;
+            blk_addr = addr;
+        } else {
+            // Data byte
+            int hi = hexDigit(*p);
+            int lo = (p + 1 < end) ? hexDigit(p[1]) : -1;
+            if (hi < 0 || lo < 0 || (p + 2 < end && hexDigit(p[2]) >= 0)) {
+                TB_ERR("Unsupported token at offset %ld of '%s' (only byte-wide Verilog HEX is supported)",
+                       (long)(p - buf), file.c_str());
+                ret = false;
+                break;
+            }
+            blk.push_back((uint8_t)((hi << 4) | lo));
+            addr++;
+            p += 2;
+        }
+    }
+    if (ret && !blk.empty()) write(blk_addr, blk.data(), blk.size());
+
+    munmap((void *)buf, st.st_size);
+    return ret;
+}
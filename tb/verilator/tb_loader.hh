@@ -0,0 +1,65 @@
+// Copyright 2026 EPFL and Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_loader.hh
+// Author: agent
+// Date: 16/10/2026
+// Description: Fast firmware loader for the Verilator testbench
+
+#if !defined(TB_LOADER_HH_)
+#define TB_LOADER_HH_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <functional>
+
+#include "tb_sram_layout.hh"
+
+// Class definition
+class TbLoader
+{
+private:
+    uint32_t *sram[TB_SRAM_NUM_BANKS]; // Verilated memory arrays
+    bool bound;
+    size_t words_written;
+
+    // Get the SRAM word an address is mapped to (NULL if outside the SRAM)
+    uint32_t *wordPtr(uint32_t addr);
+
+    // Write a block of bytes to the SRAM banks
+    void writeBytes(uint32_t addr, const uint8_t *data, size_t size);
+
+    // Load a firmware file in the different formats
+    bool loadElf(const std::string &file);
+    bool loadVerilogHex(const std::string &file);
+public:
+    TbLoader();
+    ~TbLoader();
+
+    // Bind to the SRAM arrays of the model (after the model is created)
+    bool bind();
+
+    // Load a firmware file (ELF or Verilog HEX) into the SRAM banks. Only the
+    // populated addresses are written.
+    bool load(const std::string &file);
+
+    // Get the number of SRAM words written by the last load
+    size_t getWordsWritten();
+
+    // Read and write an SRAM word while the simulation runs (e.g., to exchange
+    // data with the firmware). Return false if the address is not in the SRAM.
+    bool readWord(uint32_t addr, uint32_t &data);
+    bool writeWord(uint32_t addr, uint32_t data);
+
+    // Check whether the loader is bound to the SRAM arrays
+    bool isBound();
+};
+
+// Parse a Verilog HEX file (as produced by 'objcopy -O verilog'), calling
+// write() for each block of contiguous bytes
+typedef std::function<void(uint32_t addr, const uint8_t *data, size_t size)> tb_hex_write_t;
+bool readVerilogHex(const std::string &file, const tb_hex_write_t &write);
+
+#endif // TB_LOADER_HH_
@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "tb_profiler.hh"
+#include "tb_macros.hh"
+
+// Maximum depth of the shadow call stack
+#define PROF_MAX_STACK_DEPTH 64
+
+// Number of hottest instructions in the flat profile
+#define PROF_HOT_PCS 32
+
+// Event and cycle class names
+static const char *prof_event_names[PROF_EV_NUM] = {
+    "instret", "load", "store", "jump", "branch", "taken", "compr",
+    "jr_stall", "imiss", "ld_stall", "pipe_stall", "sleep", "dmem_stall"
+};
+static const char *prof_cycle_names[PROF_CYC_NUM] = {
+    "compute", "imiss", "ld_stall", "dmem_stall", "jr_stall", "pipe_stall", "sleep", "other"
+};
+
+// Assign a cycle to a single class. Retired instructions take precedence over
+// stalls, which are ordered from the most to the least memory-related.
+static inline prof_cycle_t classifyCycle(uint16_t events)
+{
+    if (events & (1 << PROF_EV_SLEEP)) return PROF_CYC_SLEEP;
+    if (events & (1 << PROF_EV_INSTRET)) return PROF_CYC_COMPUTE;
+    if (events & (1 << PROF_EV_IMISS)) return PROF_CYC_IMISS;
+    if (events & (1 << PROF_EV_LD_STALL)) return PROF_CYC_LD_STALL;
+    if (events & (1 << PROF_EV_DMEM_STALL)) return PROF_CYC_DMEM_STALL;
+    if (events & (1 << PROF_EV_JR_STALL)) return PROF_CYC_JR_STALL;
+    if (events & (1 << PROF_EV_PIPE_STALL)) return PROF_CYC_PIPE_STALL;
+    return PROF_CYC_OTHER;
+}
+
+static void addCounters(prof_counters_t &dst, const prof_counters_t &src)
+{
+    dst.cycles += src.cycles;
+    for (int i = 0; i < PROF_EV_NUM; i++) dst.events[i] += src.events[i];
+    for (int i = 0; i < PROF_CYC_NUM; i++) dst.classes[i] += src.classes[i];
+}
+
+TbProfiler::TbProfiler()
+{
+    this->interval = 1;
+    this->countdown = 1;
+    this->running = false;
+    this->nsamples = 0;
+    this->func = -1;
+    this->func_lo = 0;
+    this->func_hi = 0;
+    this->pc = 0;
+    this->jump = false;
+    this->node = NULL;
+}
+
+bool TbProfiler::open(TbElf &elf, unsigned int interval)
+{
+    this->functions = elf.getFunctions();
+    if (this->functions.empty()) {
+        TB_ERR("No functions found in '%s'", elf.getPath().c_str());
+        return false;
+    }
+    this->interval = interval > 0 ? interval : 1;
+    this->countdown = this->interval;
+    this->node = &this->stacks[this->stack];
+    return true;
+}
+
+void TbProfiler::start()
+{
+    this->running = true;
+}
+
+void TbProfiler::stop()
+{
+    this->running = false;
+}
+
+void TbProfiler::findFunction(uint32_t pc)
+{
+    // Look up the function containing pc (or the gap between two functions)
+    std::vector<tb_elf_func_t>::const_iterator it = std::upper_bound(
+        this->functions.begin(), this->functions.end(), pc,
+        [](uint32_t addr, const tb_elf_func_t &f) { return addr < f.addr; });
+    int f = -1;
+    this->func_lo = it == this->functions.begin() ? 0 : (it - 1)->addr + (it - 1)->size;
+    this->func_hi = it == this->functions.end() ? UINT32_MAX : it->addr;
+    if (it != this->functions.begin() && pc < (it - 1)->addr + (it - 1)->size) {
+        f = (int)(it - this->functions.begin()) - 1;
+        this->func_lo = (it - 1)->addr;
+        this->func_hi = (it - 1)->addr + (it - 1)->size;
+    }
+    this->func = f;
+}
+
+void TbProfiler::track(uint32_t pc, bool jump)
+{
+    uint32_t from = this->pc;
+    this->pc = pc;
+
+    // Sequential code and local branches do not change the call stack
+    bool in_func = pc >= this->func_lo && pc < this->func_hi;
+    if (in_func && !jump && !this->stack.empty()) return;
+    if (!in_func) this->findFunction(pc);
+    int f = this->func;
+
+    // Update the shadow call stack:
+    // - reaching the entry point of a function is a call (also when recursive);
+    // - jumping right after the call site of a frame returns from that frame;
+    // - moving to a function already on the stack (e.g., mret) unwinds to it;
+    // - anything else outside the current function replaces the top.
+    std::vector<uint32_t>::reverse_iterator call = this->calls.rend();
+    if (jump) {
+        call = std::find_if(this->calls.rbegin(), this->calls.rend(),
+                            [pc](uint32_t site) { return pc == site + 2 || pc == site + 4; });
+    }
+    if (f >= 0 && pc == this->functions[f].addr && this->stack.size() < PROF_MAX_STACK_DEPTH) {
+        this->stack.push_back(f);
+        this->calls.push_back(from);
+    } else if (call != this->calls.rend()) {
+        size_t depth = this->calls.rend() - call - 1;
+        this->stack.resize(depth);
+        this->calls.resize(depth);
+        if (this->stack.empty()) {
+            this->stack.push_back(f);
+            this->calls.push_back(from);
+        } else {
+            this->stack.back() = f;
+        }
+    } else if (in_func) {
+        return;
+    } else {
+        std::vector<int>::reverse_iterator caller = std::find(this->stack.rbegin(), this->stack.rend(), f);
+        if (caller != this->stack.rend()) {
+            this->stack.resize(this->stack.rend() - caller);
+            this->calls.resize(this->stack.size());
+        } else if (!this->stack.empty()) {
+            this->stack.back() = f;
+        } else {
+            this->stack.push_back(f);
+            this->calls.push_back(from);
+        }
+    }
+    this->node = &this->stacks[this->stack];
+}
+
+void TbProfiler::record(uint32_t pc, uint16_t events)
+{
+    // Each sample accounts for the whole sampling interval
+    prof_counters_t *node = this->node;
+    node->cycles += this->interval;
+    node->classes[classifyCycle(events)] += this->interval;
+    for (int i = 0; events != 0; i++, events >>= 1) {
+        if (events & 1) node->events[i] += this->interval;
+    }
+    this->pc_cycles[pc] += this->interval;
+    this->nsamples++;
+}
+
+std::string TbProfiler::funcName(int func)
+{
+    if (func < 0 || func >= (int)this->functions.size()) return "[unknown]";
+    return this->functions[func].name;
+}
+
+bool TbProfiler::write(const std::string &prefix)
+{
+    std::string flat_file = prefix + ".txt";
+    std::string folded_file = prefix + ".folded";
+    prof_counters_t total;
+    memset(&total, 0, sizeof(total));
+
+    // Self and inclusive counters of each function
+    std::map<int, prof_counters_t> self;
+    std::map<int, vluint64_t> incl;
+    for (std::map<std::vector<int>, prof_counters_t>::const_iterator it = this->stacks.begin(); it != this->stacks.end(); it++) {
+        if (it->first.empty() || it->second.cycles == 0) continue;
+        addCounters(total, it->second);
+        prof_counters_t &s = self[it->first.back()];
+        addCounters(s, it->second);
+
+        // Count recursive functions once
+        std::vector<int> funcs = it->first;
+        std::sort(funcs.begin(), funcs.end());
+        funcs.erase(std::unique(funcs.begin(), funcs.end()), funcs.end());
+        for (size_t i = 0; i < funcs.size(); i++) incl[funcs[i]] += it->second.cycles;
+    }
+    if (total.cycles == 0) {
+        TB_WARN("No profiling samples collected");
+        return false;
+    }
+
+    // Flat profile
+    FILE *fp = fopen(flat_file.c_str(), "w");
+    if (fp == NULL) {
+        TB_ERR("Cannot open profile file '%s': %s", flat_file.c_str(), strerror(errno));
+        return false;
+    }
+    fprintf(fp, "# Flat profile (sampling interval: %u cycles, %lu samples)\n", this->interval, this->nsamples);
+    fprintf(fp, "# Total cycles: %lu, instructions: %lu, CPI: %.3f\n", total.cycles,
+            total.events[PROF_EV_INSTRET],
+            total.events[PROF_EV_INSTRET] ? (double)total.cycles / total.events[PROF_EV_INSTRET] : 0.0);
+    fprintf(fp, "# Cycle breakdown:");
+    for (int i = 0; i < PROF_CYC_NUM; i++) {
+        fprintf(fp, " %s %.1f%%", prof_cycle_names[i], 100.0 * total.classes[i] / total.cycles);
+    }
+    fprintf(fp, "\n\n");
+
+    // Functions, sorted by self cycles
+    std::vector<std::pair<vluint64_t, int> > order;
+    for (std::map<int, prof_counters_t>::const_iterator it = self.begin(); it != self.end(); it++) {
+        order.push_back(std::make_pair(it->second.cycles, it->first));
+    }
+    std::sort(order.rbegin(), order.rend());
+
+    fprintf(fp, "%7s %12s %12s %7s", "self%", "self", "inclusive", "CPI");
+    for (int i = 0; i < PROF_EV_NUM; i++) fprintf(fp, " %10s", prof_event_names[i]);
+    for (int i = 1; i < PROF_CYC_NUM; i++) fprintf(fp, " %10s", (std::string("c_") + prof_cycle_names[i]).c_str());
+    fprintf(fp, "  function\n");
+    for (size_t n = 0; n < order.size(); n++) {
+        const prof_counters_t &c = self[order[n].second];
+        fprintf(fp, "%6.2f%% %12lu %12lu %7.3f", 100.0 * c.cycles / total.cycles, c.cycles, incl[order[n].second],
+                c.events[PROF_EV_INSTRET] ? (double)c.cycles / c.events[PROF_EV_INSTRET] : 0.0);
+        for (int i = 0; i < PROF_EV_NUM; i++) fprintf(fp, " %10lu", c.events[i]);
+        for (int i = 1; i < PROF_CYC_NUM; i++) fprintf(fp, " %10lu", c.classes[i]);
+        fprintf(fp, "  %s\n", this->funcName(order[n].second).c_str());
+    }
+
+    // Hottest instructions
+    std::vector<std::pair<vluint64_t, uint32_t> > hot;
+    for (std::unordered_map<uint32_t, vluint64_t>::const_iterator it = this->pc_cycles.begin(); it != this->pc_cycles.end(); it++) {
+        hot.push_back(std::make_pair(it->second, it->first));
+    }
+    std::sort(hot.rbegin(), hot.rend());
+    if (hot.size() > PROF_HOT_PCS) hot.resize(PROF_HOT_PCS);
+    fprintf(fp, "\n# Hottest instructions\n");
+    fprintf(fp, "%7s %12s %10s  %s\n", "cycles%", "cycles", "pc", "location");
+    for (size_t n = 0; n < hot.size(); n++) {
+        uint32_t pc = hot[n].second;
+        std::vector<tb_elf_func_t>::const_iterator it = std::upper_bound(
+            this->functions.begin(), this->functions.end(), pc,
+            [](uint32_t addr, const tb_elf_func_t &f) { return addr < f.addr; });
+        std::string loc = "[unknown]";
+        if (it != this->functions.begin() && pc < (it - 1)->addr + (it - 1)->size) {
+            char off[16];
+            snprintf(off, sizeof(off), "+0x%x", pc - (it - 1)->addr);
+            loc = (it - 1)->name + off;
+        }
+        fprintf(fp, "%6.2f%% %12lu 0x%08x  %s\n", 100.0 * hot[n].first / total.cycles, hot[n].first, pc, loc.c_str());
+    }
+    fclose(fp);
+
+    // Collapsed call stacks. The cycle class is appended as a leaf frame, so
+    // that the flame graph shows stalls and compute cycles of each function.
+    fp = fopen(folded_file.c_str(), "w");
+    if (fp == NULL) {
+        TB_ERR("Cannot open profile file '%s': %s", folded_file.c_str(), strerror(errno));
+        return false;
+    }
+    for (std::map<std::vector<int>, prof_counters_t>::const_iterator it = this->stacks.begin(); it != this->stacks.end(); it++) {
+        if (it->first.empty() || it->second.cycles == 0) continue;
+        std::string frames;
+        for (size_t i = 0; i < it->first.size(); i++) {
+            if (i > 0) frames += ";";
+            frames += this->funcName(it->first[i]);
+        }
+        for (int i = 0; i < PROF_CYC_NUM; i++) {
+            if (it->second.classes[i] == 0) continue;
+            fprintf(fp, "%s;[%s] %lu\n", frames.c_str(), prof_cycle_names[i], it->second.classes[i]);
+        }
+    }
+    fclose(fp);
+
+    TB_LOG(LOG_LOW, "Profile written to '%s' and '%s'", flat_file.c_str(), folded_file.c_str());
+    return true;
+}
+
+void TbProfiler::printSummary(unsigned int nfuncs)
+{
+    std::map<int, vluint64_t> self;
+    vluint64_t total = 0;
+    for (std::map<std::vector<int>, prof_counters_t>::const_iterator it = this->stacks.begin(); it != this->stacks.end(); it++) {
+        if (it->first.empty()) continue;
+        self[it->first.back()] += it->second.cycles;
+        total += it->second.cycles;
+    }
+    if (total == 0) return;
+
+    std::vector<std::pair<vluint64_t, int> > order;
+    for (std::map<int, vluint64_t>::const_iterator it = self.begin(); it != self.end(); it++) {
+        order.push_back(std::make_pair(it->second, it->first));
+    }
+    std::sort(order.rbegin(), order.rend());
+    TB_LOG(LOG_LOW, "Top functions by cycles:");
+    for (size_t n = 0; n < order.size() && n < nfuncs; n++) {
+        TB_LOG(LOG_LOW, "- %6.2f%% %12lu  %s", 100.0 * order[n].first / total, order[n].first,
+               this->funcName(order[n].second).c_str());
+    }
+}
+
+void TbProfiler::printConfig()
+{
+    TB_CONFIG("Profiling %lu functions every %u cycles", this->functions.size(), this->interval);
+}
@@ -0,0 +1,136 @@
+// Copyright 2026 EPFL and Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_profiler.hh
+// Author: agent
+// Date: 16/10/2026
+// Description: Firmware profiler based on the core PC and performance events
+
+#if !defined(TB_PROFILER_HH_)
+#define TB_PROFILER_HH_
+
+#include <cstdint>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <verilated.h>
+
+#include "tb_elf.hh"
+#include "Vtb_system.h"
+
+// Core performance events (bit order of prof_events_o in tb_system.sv)
+typedef enum {
+    PROF_EV_INSTRET = 0,
+    PROF_EV_LOAD,
+    PROF_EV_STORE,
+    PROF_EV_JUMP,
+    PROF_EV_BRANCH,
+    PROF_EV_BRANCH_TAKEN,
+    PROF_EV_COMPRESSED,
+    PROF_EV_JR_STALL,   // jump register hazard
+    PROF_EV_IMISS,      // instruction fetch miss
+    PROF_EV_LD_STALL,   // load-use hazard
+    PROF_EV_PIPE_STALL, // multi-cycle instruction
+    PROF_EV_SLEEP,      // core sleeping (WFI)
+    PROF_EV_DMEM_STALL, // data request not granted
+    PROF_EV_NUM
+} prof_event_t;
+
+// Cycle classes (each cycle falls in exactly one)
+typedef enum {
+    PROF_CYC_COMPUTE = 0, // an instruction retired
+    PROF_CYC_IMISS,
+    PROF_CYC_LD_STALL,
+    PROF_CYC_DMEM_STALL,
+    PROF_CYC_JR_STALL,
+    PROF_CYC_PIPE_STALL,
+    PROF_CYC_SLEEP,
+    PROF_CYC_OTHER,       // e.g., branch penalty
+    PROF_CYC_NUM
+} prof_cycle_t;
+
+// Profiling counters
+typedef struct {
+    vluint64_t cycles;
+    vluint64_t events[PROF_EV_NUM];
+    vluint64_t classes[PROF_CYC_NUM];
+} prof_counters_t;
+
+// Class definition
+class TbProfiler
+{
+private:
+    std::vector<tb_elf_func_t> functions;
+    unsigned int interval;  // sampling interval (cycles)
+    unsigned int countdown; // cycles to the next sample
+    bool running;
+    vluint64_t nsamples;
+
+    // Current function (-1: unknown) and its address range
+    int func;
+    uint32_t func_lo;
+    uint32_t func_hi;
+
+    // Last PC and whether a jump (jal/jalr) was decoded there
+    uint32_t pc;
+    bool jump;
+
+    // Shadow call stack (functions and call sites) and counters of each call stack
+    std::vector<int> stack;
+    std::vector<uint32_t> calls;
+    std::map<std::vector<int>, prof_counters_t> stacks;
+    prof_counters_t *node;
+
+    // Cycles spent on each instruction
+    std::unordered_map<uint32_t, vluint64_t> pc_cycles;
+
+    // Find the function containing an address
+    void findFunction(uint32_t pc);
+
+    // Update the call stack when the PC changes
+    void track(uint32_t pc, bool jump);
+
+    // Account a sample
+    void record(uint32_t pc, uint16_t events);
+
+    // Get the name of a function
+    std::string funcName(int func);
+public:
+    TbProfiler();
+
+    // Load the firmware functions from the ELF file
+    bool open(TbElf &elf, unsigned int interval);
+
+    // Start and stop sampling
+    void start();
+    void stop();
+
+    // Sample the core (to be called once per clock cycle). The call stack is
+    // tracked every cycle, only the attribution of cycles is sampled.
+    inline void sample(Vtb_system *dut)
+    {
+        if (!this->running) return;
+        uint32_t pc = dut->prof_pc_o;
+        uint16_t events = dut->prof_events_o;
+        if (pc != this->pc || this->stack.empty()) {
+            this->track(pc, this->jump);
+            this->jump = false;
+        }
+        if (events & (1 << PROF_EV_JUMP)) this->jump = true;
+        if (--this->countdown != 0) return;
+        this->countdown = this->interval;
+        this->record(pc, events);
+    }
+
+    // Write the flat profile (<prefix>.txt) and the collapsed call stacks
+    // (<prefix>.folded, flamegraph.pl input)
+    bool write(const std::string &prefix);
+
+    // Print the functions with the most cycles
+    void printSummary(unsigned int nfuncs);
+    void printConfig();
+};
+
+#endif // TB_PROFILER_HH_
@@ -0,0 +1,38 @@
+// Copyright 2026 EPFL and Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_sram_layout.hh
+// Author: agent
+// Date: 16/10/2026
+// Description: SRAM bank layout for the Verilator testbench firmware loader
+// NOTE: this file is generated from the X-HEEP system configuration. Do not edit.
+
+#if !defined(TB_SRAM_LAYOUT_HH_)
+#define TB_SRAM_LAYOUT_HH_
+
+#include <cstdint>
+
+// SRAM bank descriptor
+typedef struct {
+    const char *scope;  // hierarchical name of the bank memory cell
+    uint32_t start_addr; // first address of the bank (or of its interleaved group)
+    uint32_t end_addr;   // last address + 1 of the bank (or of its interleaved group)
+    uint32_t il_level;   // number of address bits selecting the bank in the interleaved group
+    uint32_t il_offset;  // position of the bank in the interleaved group
+    uint32_t num_words;  // number of 32-bit words in the bank
+} tb_sram_bank_t;
+
+// Name of the memory array inside each bank
+#define TB_SRAM_VAR_NAME "sram"
+
+// SRAM banks
+static const tb_sram_bank_t tb_sram_banks[] = {
+    {"TOP.tb_system.u_gr_heep_top.u_core_v_mini_mcu.memory_subsystem_i.ram0_i.tc_ram_i", 0x0, 0x8000, 0, 0, 8192},
+    {"TOP.tb_system.u_gr_heep_top.u_core_v_mini_mcu.memory_subsystem_i.ram1_i.tc_ram_i", 0x8000, 0x10000, 0, 0, 8192},
+    {"TOP.tb_system.u_gr_heep_top.u_core_v_mini_mcu.memory_subsystem_i.ram2_i.tc_ram_i", 0x10000, 0x18000, 1, 0, 4096},
+    {"TOP.tb_system.u_gr_heep_top.u_core_v_mini_mcu.memory_subsystem_i.ram3_i.tc_ram_i", 0x10000, 0x18000, 1, 1, 4096},
+};
+#define TB_SRAM_NUM_BANKS (sizeof(tb_sram_banks) / sizeof(tb_sram_banks[0]))
+
+#endif // TB_SRAM_LAYOUT_HH_
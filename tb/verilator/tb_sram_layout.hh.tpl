@@ -0,0 +1,37 @@
+// Copyright 2026 EPFL and Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_sram_layout.hh
+// Author: agent
+// Date: 16/10/2026
+// Description: SRAM bank layout for the Verilator testbench firmware loader
+// NOTE: this file is generated from the X-HEEP system configuration. Do not edit.
+
+#if !defined(TB_SRAM_LAYOUT_HH_)
+#define TB_SRAM_LAYOUT_HH_
+
+#include <cstdint>
+
+// SRAM bank descriptor
+typedef struct {
+    const char *scope;  // hierarchical name of the bank memory cell
+    uint32_t start_addr; // first address of the bank (or of its interleaved group)
+    uint32_t end_addr;   // last address + 1 of the bank (or of its interleaved group)
+    uint32_t il_level;   // number of address bits selecting the bank in the interleaved group
+    uint32_t il_offset;  // position of the bank in the interleaved group
+    uint32_t num_words;  // number of 32-bit words in the bank
+} tb_sram_bank_t;
+
+// Name of the memory array inside each bank
+#define TB_SRAM_VAR_NAME "sram"
+
+// SRAM banks
+static const tb_sram_bank_t tb_sram_banks[] = {
+% for bank in xheep.iter_ram_banks():
+    {"TOP.tb_system.u_gr_heep_top.u_core_v_mini_mcu.memory_subsystem_i.ram${bank.name()}_i.tc_ram_i", ${hex(bank.start_address())}, ${hex(bank.end_address())}, ${bank.il_level()}, ${bank.il_offset()}, ${bank.size()//4}},
+% endfor
+};
+#define TB_SRAM_NUM_BANKS (sizeof(tb_sram_banks) / sizeof(tb_sram_banks[0]))
+
+#endif // TB_SRAM_LAYOUT_HH_
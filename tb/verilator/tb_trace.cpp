@@ -0,0 +1,111 @@
+#include "tb_trace.hh"
+#include "tb_macros.hh"
+
+TbTracer::TbTracer()
+{
+    this->fst = NULL;
+    this->dut = NULL;
+    this->active = false;
+    this->start.type = TRIG_NONE;
+    this->stop.type = TRIG_NONE;
+    this->gpio = -1;
+    this->ring_cycles = 0;
+    this->started = false;
+    this->stopped = false;
+    this->ring_idx = 0;
+    this->ring_seg_start = 0;
+}
+
+TbTracer::~TbTracer()
+{
+    this->close();
+}
+
+void TbTracer::setWindow(const tb_trigger_t &start, const tb_trigger_t &stop)
+{
+    this->start = start;
+    this->stop = stop;
+}
+
+void TbTracer::setGpio(int gpio)
+{
+    this->gpio = gpio;
+}
+
+void TbTracer::setRing(vluint64_t ncycles)
+{
+    this->ring_cycles = ncycles;
+}
+
+void TbTracer::open(Vtb_system *dut, const std::string &filename, int depth)
+{
+    this->dut = dut;
+    this->filename = filename;
+    this->fst = new VerilatedFstC;
+    dut->trace(this->fst, depth);
+
+    // In ring buffer mode, segments are opened on demand
+    if (this->ring_cycles > 0) this->fst->open(this->segmentName(this->ring_idx).c_str());
+    else this->fst->open(filename.c_str());
+
+    this->started = this->start.type == TRIG_NONE;
+    this->active = this->started && this->gpio < 0;
+}
+
+void TbTracer::close()
+{
+    if (this->fst == NULL) return;
+    this->fst->close();
+    delete this->fst;
+    this->fst = NULL;
+
+    if (this->ring_cycles > 0) {
+        TB_LOG(LOG_LOW, "Last waveform segments: '%s' (older), '%s' (newer)",
+               this->segmentName(this->ring_idx ^ 1).c_str(), this->segmentName(this->ring_idx).c_str());
+    }
+}
+
+std::string TbTracer::segmentName(unsigned int idx)
+{
+    std::string base = this->filename;
+    size_t dot = base.find_last_of('.');
+    if (dot != std::string::npos) base = base.substr(0, dot);
+    return base + "-ring-" + std::to_string(idx) + ".fst";
+}
+
+void TbTracer::nextSegment(vluint64_t cycle)
+{
+    // Alternate between two files, so that the last two segments always hold
+    // at least the last ring_cycles cycles
+    this->fst->close();
+    this->ring_idx ^= 1;
+    this->fst->open(this->segmentName(this->ring_idx).c_str());
+    this->ring_seg_start = cycle;
+}
+
+void TbTracer::updateTriggers(vluint64_t cycle)
+{
+    bool was_active = this->active;
+
+    if (!this->started && triggerHit(this->start, this->dut, cycle)) {
+        this->started = true;
+        if (this->ring_cycles > 0) this->ring_seg_start = cycle;
+    }
+    if (this->started && !this->stopped && triggerHit(this->stop, this->dut, cycle)) {
+        this->stopped = true;
+    }
+    this->active = this->started && !this->stopped &&
+                   (this->gpio < 0 || ((this->dut->gpio_o >> this->gpio) & 0x1));
+
+    if (this->active != was_active) {
+        TB_LOG(LOG_MEDIUM, "Waveform dump %s (cycle %lu)", this->active ? "ON" : "OFF", cycle);
+    }
+}
+
+void TbTracer::printConfig()
+{
+    if (this->start.type != TRIG_NONE) TB_CONFIG("- waveform dump start: %s", triggerStr(this->start).c_str());
+    if (this->stop.type != TRIG_NONE) TB_CONFIG("- waveform dump stop: %s", triggerStr(this->stop).c_str());
+    if (this->gpio >= 0) TB_CONFIG("- waveform dump enabled by GPIO %d", this->gpio);
+    if (this->ring_cycles > 0) TB_CONFIG("- keeping the last %lu cycles of waveforms", this->ring_cycles);
+}
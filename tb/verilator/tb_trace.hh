@@ -0,0 +1,75 @@
+// Copyright 2026 EPFL and Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_trace.hh
+// Author: agent
+// Date: 16/10/2026
+// Description: Triggered waveform capture for the Verilator testbench
+
+#if !defined(TB_TRACE_HH_)
+#define TB_TRACE_HH_
+
+#include <string>
+#include <verilated.h>
+#include <verilated_fst_c.h>
+
+#include "tb_trigger.hh"
+#include "Vtb_system.h"
+
+// Class definition
+class TbTracer
+{
+private:
+    VerilatedFstC *fst;
+    Vtb_system *dut;
+    std::string filename;
+    bool active;        // waveforms are currently being dumped
+
+    // Trigger configuration
+    tb_trigger_t start; // start dumping (TRIG_NONE: from time zero)
+    tb_trigger_t stop;  // stop dumping (TRIG_NONE: never)
+    int gpio;           // only dump while this GPIO is high (-1: disabled)
+    vluint64_t ring_cycles; // only keep the last N cycles (0: disabled)
+
+    // Trigger state
+    bool started;
+    bool stopped;
+
+    // Ring buffer state
+    unsigned int ring_idx;
+    vluint64_t ring_seg_start;
+
+    // Open the next ring buffer segment
+    void nextSegment(vluint64_t cycle);
+    std::string segmentName(unsigned int idx);
+
+    // Update the trigger state
+    void updateTriggers(vluint64_t cycle);
+public:
+    TbTracer();
+    ~TbTracer();
+
+    // Configure triggers (must be called before open())
+    void setWindow(const tb_trigger_t &start, const tb_trigger_t &stop);
+    void setGpio(int gpio);
+    void setRing(vluint64_t ncycles);
+
+    // Attach to the model and open the waveform file
+    void open(Vtb_system *dut, const std::string &filename, int depth);
+    void close();
+
+    // Dump waveforms at the current time, if enabled by the triggers
+    inline void dump(vluint64_t time, vluint64_t cycle)
+    {
+        if (!this->started || this->gpio >= 0 || this->stop.type != TRIG_NONE) this->updateTriggers(cycle);
+        if (!this->active) return;
+        if (this->ring_cycles > 0 && cycle - this->ring_seg_start >= this->ring_cycles) this->nextSegment(cycle);
+        this->fst->dump(time);
+    }
+
+    // Print the trigger configuration
+    void printConfig();
+};
+
+#endif // TB_TRACE_HH_
@@ -0,0 +1,46 @@
+#include <cstdio>
+
+#include "tb_trigger.hh"
+#include "tb_macros.hh"
+
+bool parseTrigger(const std::string &spec, TbElf &elf, const std::string &elf_file, tb_trigger_t &trig)
+{
+    trig.type = TRIG_NONE;
+    trig.cycle = 0;
+    trig.addr = 0;
+    trig.name = spec;
+    if (spec.empty()) return true;
+
+    // Cycle number
+    if (spec.find_first_not_of("0123456789") == std::string::npos) {
+        trig.type = TRIG_CYCLE;
+        trig.cycle = std::stoull(spec);
+        return true;
+    }
+
+    // Firmware symbol
+    if (!elf.isOpen() && !elf.open(elf_file)) {
+        TB_ERR("Cannot resolve symbol '%s' without the firmware ELF", spec.c_str());
+        return false;
+    }
+    if (!elf.getSymbol(spec, trig.addr)) {
+        TB_ERR("Symbol '%s' not found in '%s'", spec.c_str(), elf.getPath().c_str());
+        return false;
+    }
+    trig.type = TRIG_SYMBOL;
+    return true;
+}
+
+std::string triggerStr(const tb_trigger_t &trig)
+{
+    char buf[32];
+    switch (trig.type) {
+    case TRIG_CYCLE:
+        return "cycle " + std::to_string(trig.cycle);
+    case TRIG_SYMBOL:
+        snprintf(buf, sizeof(buf), " (0x%08x)", trig.addr);
+        return "'" + trig.name + "'" + buf;
+    default:
+        return "none";
+    }
+}
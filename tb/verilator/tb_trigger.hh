@@ -0,0 +1,58 @@
+// Copyright 2026 EPFL and Politecnico di Torino.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// File: tb_trigger.hh
+// Author: agent
+// Date: 16/10/2026
+// Description: Cycle and firmware symbol triggers for the Verilator testbench
+
+#if !defined(TB_TRIGGER_HH_)
+#define TB_TRIGGER_HH_
+
+#include <cstdint>
+#include <string>
+#include <verilated.h>
+
+#include "tb_elf.hh"
+#include "Vtb_system.h"
+
+// Trigger type
+typedef enum {
+    TRIG_NONE,  // never fires
+    TRIG_CYCLE, // fires at the given simulation cycle
+    TRIG_SYMBOL // fires when the core executes the given firmware symbol
+} trig_type_t;
+
+// Trigger descriptor
+typedef struct {
+    trig_type_t type;
+    vluint64_t cycle;
+    uint32_t addr;
+    std::string name;
+} tb_trigger_t;
+
+// Parse a trigger specification (cycle number or firmware symbol). Symbols are
+// resolved from the firmware ELF, which is opened if necessary.
+bool parseTrigger(const std::string &spec, TbElf &elf, const std::string &elf_file, tb_trigger_t &trig);
+
+// Get a printable description of a trigger
+std::string triggerStr(const tb_trigger_t &trig);
+
+// Check whether a trigger fires in the current cycle. Symbols are matched
+// against the PC of the retired instructions (ID stage), so that speculative
+// fetches do not fire them and compressed instructions at half-word addresses
+// do.
+static inline bool triggerHit(const tb_trigger_t &trig, Vtb_system *dut, vluint64_t cycle)
+{
+    switch (trig.type) {
+    case TRIG_CYCLE:
+        return cycle >= trig.cycle;
+    case TRIG_SYMBOL:
+        return dut->instr_retired_o && dut->instr_pc_o == trig.addr;
+    default:
+        return false;
+    }
+}
+
+#endif // TB_TRIGGER_HH_
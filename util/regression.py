@@ -0,0 +1,437 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 Politecnico di Torino.
+# Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+#
+# File: regression.py
+# Author: agent
+# Date: 16/10/2026
+# Description: Run the software applications on the Verilator model in parallel
+#              and collect the results into a JSON/CSV database.
+
+# Applications are compiled one after the other (the X-HEEP software build
+# directory is shared), then each simulation runs in its own working directory
+# (hence with its own uart.log) on the already-built Verilator model.
+
+import argparse
+import concurrent.futures
+import csv
+import datetime
+import hashlib
+import json
+import logging
+import os
+import pathlib
+import shutil
+import subprocess
+import sys
+import time
+
+ROOT_DIR = pathlib.Path(__file__).resolve().parent.parent
+XHEEP_DIR = ROOT_DIR / "hw" / "vendor" / "x-heep"
+
+# Application directories (gr-HEEP applications shadow X-HEEP's ones)
+APP_DIRS = [
+    ROOT_DIR / "sw" / "applications",
+    XHEEP_DIR / "sw" / "applications",
+]
+
+# Result database fields
+DB_FIELDS = [
+    "app",
+    "status",
+    "exit_value",
+    "cycles",
+    "instructions",
+    "wall_time",
+    "uart_sha256",
+]
+
+# Possible application status
+STATUS_PASS = "pass"  # exit value 0
+STATUS_FAIL = "fail"  # non-zero exit value
+STATUS_TIMEOUT = "timeout"  # max cycles or wall-clock timeout reached
+STATUS_BUILD_ERROR = "build-error"  # the application did not compile
+STATUS_SIM_ERROR = "sim-error"  # the simulation did not produce any result
+STATUS_CKPT_MISMATCH = "ckpt-diff"  # the restored checkpoint differs from the uninterrupted run
+
+
+def find_apps(names, exclude):
+    """
+    Get the applications to run.
+
+    Args:
+        names (list): Application names. All the available applications if empty.
+        exclude (list): Application names to skip.
+
+    Returns:
+        list: Sorted list of application names.
+    """
+    available = set()
+    for app_dir in APP_DIRS:
+        if app_dir.is_dir():
+            available.update(d.name for d in app_dir.iterdir() if d.is_dir())
+
+    if names:
+        unknown = [n for n in names if n not in available]
+        if unknown:
+            logging.error(f"Unknown application(s): {' '.join(unknown)}")
+            sys.exit(1)
+        apps = set(names)
+    else:
+        apps = available
+
+    return sorted(apps - set(exclude))
+
+
+def find_model():
+    """
+    Look for the Verilator model built by 'make verilator-build'.
+
+    Returns:
+        pathlib.Path: Path to the model executable, or None if not found.
+    """
+    for model in sorted((ROOT_DIR / "build").glob("polito_gr_heep_gr_heep_*/sim-verilator/Vtb_system")):
+        return model
+    return None
+
+
+def build_app(app, work_dir, make_args):
+    """
+    Compile an application and copy its firmware to the working directory.
+
+    Args:
+        app (str): Application name.
+        work_dir (pathlib.Path): Application working directory.
+        make_args (list): Additional arguments for 'make app'.
+
+    Returns:
+        bool: True if the application was built successfully.
+    """
+    cmd = ["make", "--no-print-directory", "app", f"PROJECT={app}"] + make_args
+    with open(work_dir / "build.log", "w") as log:
+        res = subprocess.run(cmd, cwd=ROOT_DIR, stdout=log, stderr=subprocess.STDOUT)
+    if res.returncode != 0:
+        return False
+
+    for ext in ["hex", "elf"]:
+        fw = ROOT_DIR / "build" / "sw" / "app" / f"main.{ext}"
+        if not fw.is_file():
+            return False
+        shutil.copy(fw, work_dir / fw.name)
+    return True
+
+
+def run_app(app, work_dir, model, args, run_dir=None, plusargs=()):
+    """
+    Simulate an application in its working directory.
+
+    Args:
+        app (str): Application name.
+        work_dir (pathlib.Path): Application working directory.
+        model (pathlib.Path): Verilator model executable.
+        args (argparse.Namespace): Command-line arguments.
+        run_dir (pathlib.Path): Directory to run the simulation in (default: work_dir).
+        plusargs (tuple): Additional plusargs for the model.
+
+    Returns:
+        dict: Simulation results.
+    """
+    result = {f: None for f in DB_FIELDS}
+    result["app"] = app
+    if run_dir is None:
+        run_dir = work_dir
+    run_dir.mkdir(parents=True, exist_ok=True)
+
+    # Remove the results of previous runs
+    for f in ["stats.json", "uart.log"]:
+        (run_dir / f).unlink(missing_ok=True)
+
+    cmd = [
+        str(model),
+        f"--log_level={args.log_level}",
+        "--trace=false",
+        "--no_err=false",
+        f"+firmware={work_dir / 'main.hex'}",
+        f"+firmware_elf={work_dir / 'main.elf'}",
+        f"+boot_mode={args.boot_mode}",
+        f"+max_cycles={args.max_cycles}",
+        "+stats_file=stats.json",
+        # No pseudo-terminal, batched UART output to uart.log
+        "+UARTDPI_PTY_uart=0",
+        "+UARTDPI_BUFFER_uart=4096",
+    ] + list(plusargs)
+    start = time.monotonic()
+    with open(run_dir / "sim.log", "w") as log:
+        try:
+            subprocess.run(cmd, cwd=run_dir, stdout=log, stderr=subprocess.STDOUT,
+                           stdin=subprocess.DEVNULL, timeout=args.timeout)
+            timed_out = False
+        except subprocess.TimeoutExpired:
+            timed_out = True
+    result["wall_time"] = round(time.monotonic() - start, 3)
+
+    # UART output
+    uart_log = run_dir / "uart.log"
+    if uart_log.is_file():
+        result["uart_sha256"] = hashlib.sha256(uart_log.read_bytes()).hexdigest()
+
+    # Simulation statistics
+    stats_file = run_dir / "stats.json"
+    if timed_out:
+        result["status"] = STATUS_TIMEOUT
+    elif not stats_file.is_file():
+        result["status"] = STATUS_SIM_ERROR
+    else:
+        with open(stats_file) as f:
+            stats = json.load(f)
+        result["cycles"] = stats["cycles"]
+        result["instructions"] = stats.get("instructions")
+        result["wall_time"] = stats["wall_time"]
+        if stats["exit_valid"]:
+            result["exit_value"] = stats["exit_value"]
+            result["status"] = STATUS_PASS if stats["exit_value"] == 0 else STATUS_FAIL
+        elif stats["max_cycles_reached"]:
+            result["status"] = STATUS_TIMEOUT
+        else:
+            result["status"] = STATUS_SIM_ERROR
+
+    return result
+
+
+def run_checkpoint(app, work_dir, model, args):
+    """
+    Simulate an application, then save a checkpoint of it at a firmware symbol
+    and restore it in a new simulation. The restored run must end like the
+    uninterrupted one, and the UART output of the two halves must match it.
+
+    Args:
+        app (str): Application name.
+        work_dir (pathlib.Path): Application working directory.
+        model (pathlib.Path): Verilator model executable.
+        args (argparse.Namespace): Command-line arguments.
+
+    Returns:
+        dict: Results of the uninterrupted run (status STATUS_CKPT_MISMATCH if
+        the restored run differs).
+    """
+    result = run_app(app, work_dir, model, args)
+    if result["status"] != STATUS_PASS:
+        return result
+
+    save_dir = work_dir / "checkpoint-save"
+    restore_dir = work_dir / "checkpoint-restore"
+    ckpt_file = save_dir / "checkpoint.sav"
+    ckpt_file.unlink(missing_ok=True)
+    run_app(app, work_dir, model, args, save_dir,
+            (f"+save_checkpoint={args.checkpoint}", f"+checkpoint_file={ckpt_file}", "+checkpoint_stop=1"))
+    if not ckpt_file.is_file():
+        logging.warning(f"'{app}': no checkpoint saved at '{args.checkpoint}' (see '{save_dir / 'sim.log'}')")
+        result["status"] = STATUS_CKPT_MISMATCH
+        return result
+    restored = run_app(app, work_dir, model, args, restore_dir, (f"+restore_checkpoint={ckpt_file}",))
+
+    diffs = []
+    for f in ["status", "exit_value", "cycles", "instructions"]:
+        if restored[f] != result[f]:
+            diffs.append(f"{f} {result[f]} -> {restored[f]}")
+    uart = b""
+    for d in [save_dir, restore_dir]:
+        if (d / "uart.log").is_file():
+            uart += (d / "uart.log").read_bytes()
+    if hashlib.sha256(uart).hexdigest() != result["uart_sha256"]:
+        diffs.append("UART output changed")
+    if diffs:
+        logging.warning(f"'{app}': restored checkpoint differs: {', '.join(diffs)}")
+        result["status"] = STATUS_CKPT_MISMATCH
+    return result
+
+
+def git_revision():
+    """
+    Get the current git revision of the repository.
+
+    Returns:
+        str: Commit hash, with '-dirty' appended if there are local changes.
+    """
+    try:
+        rev = subprocess.check_output(["git", "rev-parse", "HEAD"], cwd=ROOT_DIR, text=True).strip()
+        dirty = subprocess.run(["git", "diff", "--quiet", "HEAD"], cwd=ROOT_DIR).returncode != 0
+        return rev + ("-dirty" if dirty else "")
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def write_db(results, outdir, args):
+    """
+    Write the result database in JSON and CSV format. Results are sorted by
+    application name so that databases from different commits can be diffed.
+
+    Args:
+        results (list): Results of each application.
+        outdir (pathlib.Path): Output directory.
+        args (argparse.Namespace): Command-line arguments.
+    """
+    results = sorted(results, key=lambda r: r["app"])
+
+    db = {
+        "revision": git_revision(),
+        "date": datetime.datetime.now().isoformat(timespec="seconds"),
+        "boot_mode": args.boot_mode,
+        "max_cycles": args.max_cycles,
+        "results": {r["app"]: {f: r[f] for f in DB_FIELDS if f != "app"} for r in results},
+    }
+    with open(outdir / "results.json", "w") as f:
+        json.dump(db, f, indent=2, sort_keys=True)
+        f.write("\n")
+
+    with open(outdir / "results.csv", "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=DB_FIELDS)
+        writer.writeheader()
+        writer.writerows(results)
+
+    logging.info(f"Results written to '{outdir / 'results.json'}' and '{outdir / 'results.csv'}'")
+
+
+def compare_db(results, baseline_file):
+    """
+    Print the differences with respect to a baseline result database.
+
+    Args:
+        results (list): Results of each application.
+        baseline_file (pathlib.Path): Baseline JSON database.
+    """
+    with open(baseline_file) as f:
+        baseline = json.load(f)
+    print(f"\nComparison with '{baseline_file}' (revision {baseline.get('revision', 'unknown')}):")
+
+    changes = 0
+    for r in sorted(results, key=lambda r: r["app"]):
+        old = baseline["results"].get(r["app"])
+        if old is None:
+            print(f"  {r['app']:<40} new application")
+            changes += 1
+            continue
+        diffs = []
+        if r["status"] != old["status"]:
+            diffs.append(f"status {old['status']} -> {r['status']}")
+        if r["uart_sha256"] != old["uart_sha256"]:
+            diffs.append("UART output changed")
+        if r["cycles"] and old["cycles"] and r["cycles"] != old["cycles"]:
+            delta = 100.0 * (r["cycles"] - old["cycles"]) / old["cycles"]
+            diffs.append(f"cycles {old['cycles']} -> {r['cycles']} ({delta:+.2f}%)")
+        if diffs:
+            print(f"  {r['app']:<40} {', '.join(diffs)}")
+            changes += 1
+    if changes == 0:
+        print("  no changes")
+
+
+def print_summary(results):
+    """
+    Print a summary table of the results.
+
+    Args:
+        results (list): Results of each application.
+    """
+    print(f"\n{'Application':<40} {'Status':<12} {'Exit':>5} {'Cycles':>12} {'Time [s]':>10}")
+    print("-" * 83)
+    for r in sorted(results, key=lambda r: r["app"]):
+        exit_value = "-" if r["exit_value"] is None else r["exit_value"]
+        cycles = "-" if r["cycles"] is None else r["cycles"]
+        wall_time = "-" if r["wall_time"] is None else f"{r['wall_time']:.1f}"
+        print(f"{r['app']:<40} {r['status']:<12} {exit_value:>5} {cycles:>12} {wall_time:>10}")
+    print("-" * 83)
+    npass = sum(1 for r in results if r["status"] == STATUS_PASS)
+    print(f"{npass}/{len(results)} applications passed")
+
+
+def main():
+    parser = argparse.ArgumentParser(prog="regression.py",
+                                     description="Run the software applications on the Verilator model in parallel.")
+    parser.add_argument("apps", nargs="*",
+                        help="Applications to run (default: all the gr-HEEP and X-HEEP applications)")
+    parser.add_argument("--exclude", "-x", nargs="*", default=[],
+                        help="Applications to skip")
+    parser.add_argument("--jobs", "-j", type=int, default=os.cpu_count(),
+                        help="Number of concurrent simulations (default: number of host cores)")
+    parser.add_argument("--model", type=pathlib.Path,
+                        help="Verilator model executable (default: the one built by 'make verilator-build')")
+    parser.add_argument("--outdir", "-o", type=pathlib.Path, default=ROOT_DIR / "build" / "regression",
+                        help="Output directory (one working directory per application)")
+    parser.add_argument("--no-build", action="store_true",
+                        help="Do not compile the applications (reuse the firmware in the working directories)")
+    parser.add_argument("--make-args", nargs="*", default=[],
+                        help="Additional arguments for 'make app' (e.g., ARCH=rv32imc LINKER=on_chip)")
+    parser.add_argument("--boot-mode", default="force",
+                        help="Simulation boot mode (default: force)")
+    parser.add_argument("--max-cycles", type=int, default=1200000,
+                        help="Maximum number of simulated cycles (default: 1200000)")
+    parser.add_argument("--timeout", type=float, default=None,
+                        help="Wall-clock timeout of each simulation in seconds")
+    parser.add_argument("--log-level", default="LOG_LOW",
+                        help="Testbench log level (default: LOG_LOW)")
+    parser.add_argument("--checkpoint", metavar="SYMBOL",
+                        help="Also save a checkpoint at the given firmware symbol and check that restoring it "
+                             "gives the same results (requires the 'sim' target model)")
+    parser.add_argument("--baseline", "-b", type=pathlib.Path,
+                        help="Result database (JSON) to compare the results with")
+    parser.add_argument("--verbose", "-v", action="store_true",
+                        help="Increase verbosity")
+    args = parser.parse_args()
+
+    logging.basicConfig(level=logging.DEBUG if args.verbose else logging.INFO,
+                        format="%(levelname)s: %(message)s")
+
+    # Simulation model
+    model = args.model.resolve() if args.model else find_model()
+    if model is None or not model.is_file():
+        logging.error("Verilator model not found. Run 'make verilator-build' first or use --model")
+        sys.exit(1)
+    logging.debug(f"Verilator model: {model}")
+
+    apps = find_apps(args.apps, args.exclude)
+    outdir = args.outdir.resolve()
+    results = []
+
+    # Build the applications (sequentially)
+    to_run = []
+    for i, app in enumerate(apps):
+        work_dir = outdir / app
+        work_dir.mkdir(parents=True, exist_ok=True)
+        if args.no_build:
+            built = (work_dir / "main.hex").is_file()
+        else:
+            logging.info(f"[{i + 1}/{len(apps)}] Building '{app}'...")
+            built = build_app(app, work_dir, args.make_args)
+        if built:
+            to_run.append(app)
+        else:
+            logging.warning(f"'{app}' could not be built (see '{work_dir / 'build.log'}')")
+            result = {f: None for f in DB_FIELDS}
+            result.update(app=app, status=STATUS_BUILD_ERROR)
+            results.append(result)
+
+    # Run the simulations (in parallel)
+    logging.info(f"Simulating {len(to_run)} applications on {args.jobs} cores...")
+    with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as executor:
+        run = run_checkpoint if args.checkpoint else run_app
+        futures = {executor.submit(run, app, outdir / app, model, args): app for app in to_run}
+        for future in concurrent.futures.as_completed(futures):
+            result = future.result()
+            logging.info(f"'{result['app']}': {result['status']}")
+            results.append(result)
+
+    # Write and print the results
+    write_db(results, outdir, args)
+    print_summary(results)
+    if args.baseline:
+        compare_db(results, args.baseline)
+
+    if any(r["status"] != STATUS_PASS for r in results):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
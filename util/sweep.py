@@ -0,0 +1,351 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 Politecnico di Torino.
+# Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+#
+# File: sweep.py
+# Author: agent
+# Date: 16/10/2026
+# Description: Design-space sweep. For each configuration of a parameter
+#              matrix, regenerate gr-HEEP, build the Verilator model, run a
+#              fixed set of applications and collect the cycles, the retired
+#              instructions and the exit status into a comparison table.
+
+# Configurations are evaluated one after the other, since they share the
+# generated RTL and the Verilator build directory; the applications of a
+# configuration are simulated in parallel (see regression.py). The default
+# configuration is regenerated at the end of the sweep.
+
+import argparse
+import concurrent.futures
+import copy
+import csv
+import datetime
+import itertools
+import json
+import logging
+import os
+import pathlib
+import subprocess
+import sys
+
+import hjson
+
+from regression import (DB_FIELDS, ROOT_DIR, STATUS_BUILD_ERROR, STATUS_PASS, build_app, find_apps, find_model,
+                        git_revision, run_app)
+
+# Default gr-HEEP configuration (cpu_features are overridden from here)
+GR_HEEP_CFG = ROOT_DIR / "config" / "gr-heep-cfg.hjson"
+
+# Swept parameters and the makefile variables they are passed with
+MAKE_VARS = {
+    "bus": "BUS",
+    "memory_banks": "MEMORY_BANKS",
+    "memory_banks_il": "MEMORY_BANKS_IL",
+}
+PARAMS = list(MAKE_VARS) + ["cpu_features"]
+
+# Status of the applications of a configuration that could not be generated or built
+STATUS_HW_ERROR = "hw-error"
+
+
+def load_points(cfg_file):
+    """
+    Expand the parameter matrix of the sweep configuration file.
+
+    Args:
+        cfg_file (pathlib.Path): Sweep configuration file (HJSON).
+
+    Returns:
+        tuple: List of configurations (dict with one value per parameter, None
+        for the default) and list of application names from the file.
+    """
+    with open(cfg_file) as f:
+        cfg = hjson.load(f)
+
+    matrix = cfg.get("matrix", {})
+    unknown = [p for p in matrix if p not in PARAMS]
+    if unknown:
+        logging.error(f"Unknown sweep parameter(s): {' '.join(unknown)}")
+        sys.exit(1)
+
+    values = [matrix.get(p) or [None] for p in PARAMS]
+    points = []
+    for combination in itertools.product(*values):
+        point = dict(zip(PARAMS, combination))
+        if any(all(point.get(k) == v for k, v in ex.items()) for ex in cfg.get("exclude", [])):
+            continue
+        points.append(point)
+
+    return points, cfg.get("apps", [])
+
+
+def point_label(point):
+    """
+    Get a short name for a configuration (also used as its output directory).
+
+    Args:
+        point (dict): Configuration.
+
+    Returns:
+        str: Label, e.g., 'NtoM-b4-il2-corev_pulp'.
+    """
+    parts = []
+    if point["bus"] is not None:
+        parts.append(str(point["bus"]))
+    if point["memory_banks"] is not None:
+        parts.append(f"b{point['memory_banks']}")
+    if point["memory_banks_il"] is not None:
+        parts.append(f"il{point['memory_banks_il']}")
+    features = point["cpu_features"] or {}
+    parts.extend(k if v is True else f"{k}={v}" for k, v in sorted(features.items()) if v is not False)
+    return "-".join(parts) if parts else "default"
+
+
+def make_vars(point, work_dir):
+    """
+    Get the makefile variables selecting a configuration.
+
+    Args:
+        point (dict): Configuration.
+        work_dir (pathlib.Path): Configuration working directory, where the
+            gr-HEEP configuration file with the CPU features is written.
+
+    Returns:
+        list: Variable assignments for 'make'.
+    """
+    args = [f"{var}={point[p]}" for p, var in MAKE_VARS.items() if point[p] is not None]
+
+    # The CPU features come from the gr-HEEP configuration file only
+    args.append("COREV_PULP=")
+    if point["cpu_features"]:
+        with open(GR_HEEP_CFG) as f:
+            cfg = hjson.load(f, use_decimal=True)
+        cfg["cpu_features"].update(point["cpu_features"])
+        cfg_file = work_dir / GR_HEEP_CFG.name
+        with open(cfg_file, "w") as f:
+            hjson.dump(cfg, f)
+        args.append(f"GR_HEEP_GEN_CFG={cfg_file}")
+
+    return args
+
+
+def build_hw(work_dir, args):
+    """
+    Regenerate gr-HEEP and build the Verilator model.
+
+    Args:
+        work_dir (pathlib.Path): Log directory.
+        args (list): Makefile variables selecting the configuration.
+
+    Returns:
+        bool: True if the model was built successfully.
+    """
+    for target, log_name in [("gr-heep-gen-force", "gen.log"), ("verilator-build", "model.log")]:
+        cmd = ["make", "--no-print-directory", target] + args
+        logging.debug(f"Running '{' '.join(cmd)}'")
+        with open(work_dir / log_name, "w") as log:
+            res = subprocess.run(cmd, cwd=ROOT_DIR, stdout=log, stderr=subprocess.STDOUT)
+        if res.returncode != 0:
+            logging.warning(f"'make {target}' failed (see '{work_dir / log_name}')")
+            return False
+    return True
+
+
+def run_point(point, apps, work_dir, args):
+    """
+    Evaluate a configuration.
+
+    Args:
+        point (dict): Configuration.
+        apps (list): Application names.
+        work_dir (pathlib.Path): Configuration working directory.
+        args (argparse.Namespace): Command-line arguments.
+
+    Returns:
+        list: Results of each application.
+    """
+    work_dir.mkdir(parents=True, exist_ok=True)
+    results = []
+
+    # Generate and build the hardware
+    model = None
+    if build_hw(work_dir, make_vars(point, work_dir)):
+        model = find_model()
+    if model is None:
+        for app in apps:
+            result = {f: None for f in DB_FIELDS}
+            result.update(app=app, status=STATUS_HW_ERROR)
+            results.append(result)
+        return results
+
+    # Build the applications (sequentially)
+    to_run = []
+    for app in apps:
+        app_dir = work_dir / app
+        app_dir.mkdir(exist_ok=True)
+        if build_app(app, app_dir, args.make_args):
+            to_run.append(app)
+        else:
+            logging.warning(f"'{app}' could not be built (see '{app_dir / 'build.log'}')")
+            result = {f: None for f in DB_FIELDS}
+            result.update(app=app, status=STATUS_BUILD_ERROR)
+            results.append(result)
+
+    # Run the simulations (in parallel)
+    with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as executor:
+        futures = [executor.submit(run_app, app, work_dir / app, model, args) for app in to_run]
+        for future in concurrent.futures.as_completed(futures):
+            results.append(future.result())
+
+    return results
+
+
+def write_db(sweep, outdir, args):
+    """
+    Write the sweep results in JSON and CSV format.
+
+    Args:
+        sweep (list): (label, configuration, results) of each configuration.
+        outdir (pathlib.Path): Output directory.
+        args (argparse.Namespace): Command-line arguments.
+    """
+    db = {
+        "revision": git_revision(),
+        "date": datetime.datetime.now().isoformat(timespec="seconds"),
+        "boot_mode": args.boot_mode,
+        "max_cycles": args.max_cycles,
+        "configs": {
+            label: {
+                "params": point,
+                "results": {r["app"]: {f: r[f] for f in DB_FIELDS if f != "app"} for r in results},
+            }
+            for label, point, results in sweep
+        },
+    }
+    with open(outdir / "sweep.json", "w") as f:
+        json.dump(db, f, indent=2, sort_keys=True)
+        f.write("\n")
+
+    with open(outdir / "sweep.csv", "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=["config"] + PARAMS + DB_FIELDS)
+        writer.writeheader()
+        for label, point, results in sweep:
+            params = dict(point, cpu_features=json.dumps(point["cpu_features"] or {}, sort_keys=True))
+            for r in sorted(results, key=lambda r: r["app"]):
+                writer.writerow(dict(config=label, **params, **r))
+
+    logging.info(f"Results written to '{outdir / 'sweep.json'}' and '{outdir / 'sweep.csv'}'")
+
+
+def print_table(sweep):
+    """
+    Print the comparison table: for each application, the results on every
+    configuration, with the cycles relative to the first configuration.
+
+    Args:
+        sweep (list): (label, configuration, results) of each configuration.
+    """
+    labels = [label for label, _, _ in sweep]
+    by_app = {}
+    for label, _, results in sweep:
+        for r in results:
+            by_app.setdefault(r["app"], {})[label] = r
+    width = max([len(label) + 2 for label in labels] + [13])
+
+    print(f"\n{'Configuration':<{width}} {'Status':<12} {'Exit':>5} {'Cycles':>12} {'Instructions':>12} "
+          f"{'IPC':>6} {'vs first':>9}")
+    print("-" * (width + 62))
+    for app in sorted(by_app):
+        print(app)
+        ref = by_app[app].get(labels[0], {}).get("cycles")
+        for label in labels:
+            r = by_app[app].get(label)
+            if r is None:
+                continue
+            exit_value = "-" if r["exit_value"] is None else r["exit_value"]
+            cycles = "-" if r["cycles"] is None else r["cycles"]
+            instructions = "-" if r["instructions"] is None else r["instructions"]
+            ipc = f"{r['instructions'] / r['cycles']:.3f}" if r["cycles"] and r["instructions"] is not None else "-"
+            delta = f"{100.0 * (r['cycles'] - ref) / ref:+.2f}%" if ref and r["cycles"] else "-"
+            print(f"  {label:<{width - 2}} {r['status']:<12} {exit_value:>5} {cycles:>12} {instructions:>12} "
+                  f"{ipc:>6} {delta:>9}")
+    print("-" * (width + 62))
+    for label, _, results in sweep:
+        npass = sum(1 for r in results if r["status"] == STATUS_PASS)
+        print(f"{label:<{width}} {npass}/{len(results)} applications passed")
+
+
+def main():
+    parser = argparse.ArgumentParser(prog="sweep.py",
+                                     description="Evaluate the applications on a matrix of gr-HEEP configurations.")
+    parser.add_argument("--cfg", "-c", type=pathlib.Path, default=ROOT_DIR / "config" / "sweep.hjson",
+                        help="Sweep configuration file (default: config/sweep.hjson)")
+    parser.add_argument("--apps", nargs="*", default=None,
+                        help="Applications to run (default: the ones in the configuration file)")
+    parser.add_argument("--jobs", "-j", type=int, default=os.cpu_count(),
+                        help="Number of concurrent simulations (default: number of host cores)")
+    parser.add_argument("--outdir", "-o", type=pathlib.Path, default=ROOT_DIR / "build" / "sweep",
+                        help="Output directory (one working directory per configuration)")
+    parser.add_argument("--make-args", nargs="*", default=[],
+                        help="Additional arguments for 'make app' (e.g., ARCH=rv32imc LINKER=on_chip)")
+    parser.add_argument("--boot-mode", default="force",
+                        help="Simulation boot mode (default: force)")
+    parser.add_argument("--max-cycles", type=int, default=1200000,
+                        help="Maximum number of simulated cycles (default: 1200000)")
+    parser.add_argument("--timeout", type=float, default=None,
+                        help="Wall-clock timeout of each simulation in seconds")
+    parser.add_argument("--log-level", default="LOG_LOW",
+                        help="Testbench log level (default: LOG_LOW)")
+    parser.add_argument("--dry-run", "-n", action="store_true",
+                        help="Only list the configurations")
+    parser.add_argument("--no-restore", action="store_true",
+                        help="Leave the last configuration generated instead of the default one")
+    parser.add_argument("--verbose", "-v", action="store_true",
+                        help="Increase verbosity")
+    args = parser.parse_args()
+
+    logging.basicConfig(level=logging.DEBUG if args.verbose else logging.INFO,
+                        format="%(levelname)s: %(message)s")
+
+    points, cfg_apps = load_points(args.cfg)
+    apps = find_apps(args.apps if args.apps is not None else cfg_apps, [])
+    if not points or not apps:
+        logging.error("Nothing to run")
+        sys.exit(1)
+    labels = [point_label(p) for p in points]
+    if len(set(labels)) != len(labels):
+        logging.error("Duplicate configurations in the sweep")
+        sys.exit(1)
+    logging.info(f"{len(points)} configurations x {len(apps)} applications")
+    if args.dry_run:
+        for label in labels:
+            print(label)
+        return
+
+    outdir = args.outdir.resolve()
+    outdir.mkdir(parents=True, exist_ok=True)
+    sweep = []
+    try:
+        for i, (label, point) in enumerate(zip(labels, points)):
+            logging.info(f"[{i + 1}/{len(points)}] Evaluating '{label}'...")
+            results = run_point(point, apps, outdir / label, args)
+            for r in sorted(results, key=lambda r: r["app"]):
+                logging.info(f"'{label}' '{r['app']}': {r['status']}")
+            sweep.append((label, copy.deepcopy(point), results))
+    finally:
+        if sweep:
+            write_db(sweep, outdir, args)
+        if not args.no_restore:
+            logging.info("Regenerating the default configuration...")
+            build_hw(outdir, ["COREV_PULP="])
+
+    print_table(sweep)
+
+    if any(r["status"] != STATUS_PASS for _, _, results in sweep for r in results):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()